@@ -5,7 +5,7 @@ CONFIG -= qt
 
 QMAKE_CXXFLAGS += -fprofile-arcs -ftest-coverage -O0
 
-SUBDIRS = app tests
+SUBDIRS = core app tests bench runner packer
 
 CONFIG += ordered
 
@@ -16,6 +16,11 @@ QMAKE_EXTRA_TARGETS += docs
 # Включение целей по умолчанию
 PRE_TARGETDEPS += $$QMAKE_EXTRA_TARGETS
 
+# Цель для сборки пака ресурсов (после изменения картинок в app/src)
+assets.commands = cd app ; ../packer/packer
+assets.depends = all
+QMAKE_EXTRA_TARGETS += assets
+
 # Цель для проверки утечек памяти с Valgrind
 valgrind_check.commands = cd app ; valgrind --suppressions=suppressions.supp --leak-check=full ./app
 valgrind_check.depends = all
@@ -0,0 +1,72 @@
+#include "alloccounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::size_t> g_alloc_count(0); ///< Количество выделений памяти.
+
+    /**
+     * @brief Выделяет память и учитывает выделение в счетчике.
+     * @param size Размер блока в байтах.
+     * @return Указатель на блок или nullptr при нехватке памяти.
+     */
+    void* counted_malloc(std::size_t size)
+    {
+        g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+
+std::size_t AllocCounter::get_count(void)
+{
+    return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    void* ptr = counted_malloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* ptr = counted_malloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,23 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * @brief Счетчик выделений динамической памяти.
+ *
+ * Глобальные operator new/delete приложения заменены (см. alloccounter.cpp)
+ * и увеличивают этот счетчик при каждом выделении памяти. Разность двух
+ * показаний дает количество выделений между ними.
+ */
+class AllocCounter
+{
+public:
+    /**
+     * @brief Получить количество выделений памяти с запуска программы.
+     * @return Количество вызовов operator new.
+     */
+    static std::size_t get_count(void);
+};
+
+#endif // ALLOCCOUNTER_H
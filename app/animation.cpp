@@ -5,109 +5,156 @@
 // ==========================================================
 
 AnimationLogic::AnimationLogic(std::size_t n, int32_t change_time)
-    : m_max_sprite_index(n),       // Установка максимального индекса спрайта
+    : m_sprite_count(n),          // Установка количества спрайтов
       m_change_time(change_time)  // Установка времени смены спрайтов
 {
-    if (m_max_sprite_index <= 0)
+    if (m_sprite_count <= 0)
         throw std::runtime_error("Incorrect sprite num (probably error with download");
     if (m_change_time <= 0)
         throw std::runtime_error("Incorrect change time value");
 }
 
-void AnimationLogic::start(void)
+void AnimationLogic::start(int32_t cur_time)
 {
-    m_cur_sprite_index = 0;  ///< Сбрасываем индекс текущего спрайта в начало
-    m_last_time = -1;        ///< Сбрасываем последнее время изменения
+    m_start_time = cur_time; ///< Запоминаем время начала (или ждем первого запроса кадра)
 }
 
 bool AnimationLogic::is_end(int32_t cur_time) const
 {
-    if (need_next_sprite(cur_time))
-    {
-        // Вычисляем индекс следующего спрайта с учетом циклической анимации
-        std::size_t next_index = (m_cur_sprite_index + 1) % m_max_sprite_index;
-
-        // Если вернулись в начало анимации, значит она закончилась
-        if (next_index == 0)
-        {
-            return true;
-        }
-    }
-    return false;
+    // Закончилась, если прошло время показа всех кадров
+    return static_cast<std::size_t>(get_changes_count(cur_time)) >= m_sprite_count;
 }
 
 std::size_t AnimationLogic::get_current_sprite_index(int32_t cur_time)
 {
-    if (need_next_sprite(cur_time))
-    {
-        // Обновляем индекс текущего спрайта с учетом циклической анимации
-        m_cur_sprite_index = (m_cur_sprite_index + 1) % m_max_sprite_index;
-        // Обновляем последнее время изменения
-        m_last_time = cur_time;
-
-    }
+    if (m_start_time == -1) // Анимация начинается с первого запроса кадра
+        m_start_time = cur_time;
 
-    if (m_last_time == -1)// Устанавливаем начальное значение
-    {
-        m_last_time = cur_time;
-    }
+    // Циклическая анимация: после последнего кадра снова первый
+    return static_cast<std::size_t>(get_changes_count(cur_time)) % m_sprite_count;
+}
 
-    return m_cur_sprite_index;
+int32_t AnimationLogic::get_change_time(void) const
+{
+    return m_change_time;
 }
 
-bool AnimationLogic::need_next_sprite(int32_t cur_time) const
+int32_t AnimationLogic::get_changes_count(int32_t cur_time) const
 {
-    ///< Если последнее время было установлено и прошло достаточно времени для смены спрайта
-    return m_last_time != -1 && cur_time - m_last_time >= m_change_time;
+    ///< Время до начала (например, кадр нарисован раньше обновления) считается началом
+    if (m_start_time == -1 || cur_time <= m_start_time)
+        return 0;
+    return (cur_time - m_start_time) / m_change_time;
 }
 
 // =====================================================
 // ===================== Animation =====================
 // =====================================================
 
-Animation::Animation(sf::Texture& tex, std::size_t n, int32_t change_time)
-    : AnimationLogic(n, change_time) // Инициализация базового класса AnimationLogic
+FrameGeometryCache Animation::ms_geometry_cache;
+
+Animation::Animation(const std::vector<AtlasFrame>& frames, int32_t change_time)
+    : AnimationLogic(frames.size(), change_time), // Инициализация базового класса AnimationLogic
+      m_frames(&frames)
 {
-    ///> нарезаем текстуру на спрайты
-    sf::Vector2u tex_size = tex.getSize();  // Получаем размер текстуры
-    int one_frame_width = tex_size.x / n;  // Вычисляем ширину одного кадра (спрайта)
-    sf::IntRect to_cut(0, 0, one_frame_width, tex_size.y);  // Инициализируем прямоугольник для разрезания текстуры
-    m_sprites.reserve(n);   // Выделяем место в векторе для спрайтов
+    ///> по умолчанию кадр отображается в своем размере
+    m_size = sf::Vector2f(static_cast<float>(frames[0].rect.width), static_cast<float>(frames[0].rect.height));
+}
 
-    for (std::size_t i = 0; i < n; ++i) {
-        m_sprites.emplace_back(tex, to_cut); // Добавляем спрайт в конец вектора m_sprites
+const AtlasFrame& Animation::get_frame(int32_t cur_time)
+{
+    return (*m_frames)[get_frame_index(cur_time)];  // Возвращаем кадр по текущему индексу
+}
 
-        to_cut.left += one_frame_width;  // Сдвигаем левую границу прямоугольника для следующего спрайта
-    }
+const sf::Vector2f& Animation::get_size(void) const
+{
+    return m_size;
 }
 
-sf::Sprite Animation::get_sprite(int32_t cur_time)
+void Animation::draw(SpriteBatch& batch, SpriteBatch::Layer layer, const sf::Vector2f& position, int32_t cur_time)
 {
-    std::size_t index = get_current_sprite_index(cur_time);  // Получаем текущий индекс спрайта из базового класса
-    return m_sprites[index];  // Возвращаем спрайт по текущему индексу
+    // Готовые вершины кадра сдвигаются на позицию и сразу пишутся в пакет
+    std::size_t index = get_frame_index(cur_time);
+    const AtlasFrame& frame = (*m_frames)[index];
+    if (frame.texture != nullptr)
+        batch.add(layer, *frame.texture, get_frame_vertices(index), FrameGeometryCache::mc_frame_vertices, position);
+}
+
+const sf::Texture* Animation::build(std::vector<sf::Vertex>& vertices, const sf::Vector2f& position, int32_t cur_time)
+{
+    std::size_t index = get_frame_index(cur_time);
+    const AtlasFrame& frame = (*m_frames)[index];
+    if (frame.texture != nullptr)
+        SpriteBatch::append_vertices(vertices, get_frame_vertices(index), FrameGeometryCache::mc_frame_vertices, position);
+    return frame.texture;
 }
 
 bool Animation::is_end(int32_t cur_time) const
 {
+    if (m_scheduler != nullptr)
+        return m_scheduler->is_finished(m_handle);
     return AnimationLogic::is_end(cur_time);
 }
 
-void Animation::start(void)
+void Animation::start(int32_t cur_time)
 {
-    AnimationLogic::start();
+    if (m_scheduler != nullptr)
+        m_scheduler->restart(m_handle, cur_time);
+    AnimationLogic::start(cur_time);
 }
 
 void Animation::resize(const sf::Vector2f& new_size)
 {
-    std::for_each(m_sprites.begin(), m_sprites.end(), [&new_size](sf::Sprite& sprite) {
-        sprite.setScale(1.f, 1.f);  // Сбрасываем масштаб спрайта
+    if (new_size == m_size)
+        return;
+    m_size = new_size;
+    m_geometry = nullptr; // Вершины в новом размере возьмем из кэша при отрисовке
+}
 
-        sf::FloatRect sprite_bounds = sprite.getLocalBounds();  // Получаем локальные границы спрайта
+void Animation::prepare_geometry(void)
+{
+    get_frame_vertices(0);
+}
 
-        // Изменяем размер спрайта
-        float imageScale_x = new_size.x / sprite_bounds.width;
-        float imageScale_y = new_size.y / sprite_bounds.height;
+FrameGeometryCache& Animation::get_geometry_cache(void)
+{
+    return ms_geometry_cache;
+}
 
-        sprite.setScale(imageScale_x, imageScale_y);  // Применяем новый масштаб
-    });
+std::size_t Animation::get_frame_index(int32_t cur_time)
+{
+    // Номер кадра берем у планировщика или вычисляем своими часами
+    return m_scheduler != nullptr ? m_scheduler->get_frame(m_handle) : get_current_sprite_index(cur_time);
+}
+
+const sf::Vertex* Animation::get_frame_vertices(std::size_t index)
+{
+    if (m_geometry == nullptr)
+        m_geometry = &ms_geometry_cache.get(*m_frames, m_size);
+    return &(*m_geometry)[index * FrameGeometryCache::mc_frame_vertices];
+}
+
+void Animation::schedule(AnimationScheduler& scheduler, bool looping, int32_t start_time)
+{
+    unschedule();
+    m_scheduler = &scheduler;
+    m_handle = scheduler.add(m_frames->size(), get_change_time(), looping, start_time);
+}
+
+void Animation::unschedule(void)
+{
+    if (m_scheduler == nullptr)
+        return;
+    m_scheduler->remove(m_handle);
+    m_scheduler = nullptr;
+}
+
+bool Animation::is_scheduled(void) const
+{
+    return m_scheduler != nullptr;
+}
+
+AnimationScheduler::Handle Animation::get_handle(void) const
+{
+    return m_handle;
 }
@@ -1,145 +1,269 @@
-#ifndef ANIMATION_H
-#define ANIMATION_H
-
-#include <SFML/Graphics.hpp>
-#include <vector>
-#include <algorithm>  // Для std::for_each
-#include <stdexcept>
-
-/**
- * @brief Класс для логики анимации, который не зависит от графического интерфейса.
- */
-class AnimationLogic
-{
-public:
-    /**
-     * @brief Конструктор по умолчанию.
-     */
-    AnimationLogic(void) = default;
-
-    /**
-     * @brief Конструктор с параметрами.
-     * @param n Количество спрайтов в анимации.
-     * @param change_time Время смены спрайтов в миллисекундах.
-     * @throw std::runtime_error при некорректных данных (n должно быть > 0 и change_time должно быть > 0)
-     */
-    AnimationLogic(std::size_t n, int32_t change_time);
-
-    /**
-     * @brief Конструктор перемещения.
-     * @param other Другой объект AnimationLogic для перемещения.
-     */
-    AnimationLogic(AnimationLogic&& other) noexcept = default;
-
-    /**
-     * @brief Виртуальный деструктор.
-     */
-    virtual ~AnimationLogic(void) = default;
-
-    /**
-     * @brief Оператор присваивания перемещением.
-     * @param other Другой объект AnimationLogic для присваивания.
-     * @return Ссылка на текущий объект AnimationLogic.
-     */
-    AnimationLogic& operator=(AnimationLogic&& other) noexcept = default;
-
-    /**
-     * @brief Метод для начала нециклической анимации с начала.
-     */
-    void start(void);
-
-    /**
-     * @brief Метод для возращения статуса нециклической анимации.
-     * @param cur_time Текущее время в миллисекундах.
-     * @return true если есть спрайт для этой анимации, иначе false
-     */
-    bool is_end(int32_t cur_time) const;
-
-    /**
-     * @brief Вычислить текущий индекс кадра на основе текущего времени.
-     * @param cur_time Текущее время в миллисекундах.
-     * @return Индекс текущего спрайта.
-     */
-    std::size_t get_current_sprite_index(int32_t cur_time);
-
-private:
-    /**
-     * @brief Проверить, нужно ли переключить на следующий спрайт.
-     * @param cur_time Текущее время в миллисекундах.
-     * @return true, если нужно переключить на следующий спрайт, false в противном случае.
-     */
-    bool need_next_sprite(int32_t cur_time) const;
-
-    std::size_t m_cur_sprite_index = 0; ///< Текущий индекс спрайта.
-    std::size_t m_max_sprite_index; ///< Максимальный индекс спрайта.
-    int32_t m_change_time;          ///< Время смены спрайта в миллисекундах.
-    int32_t m_last_time = -1;            ///< Время последнего обновления спрайта в миллисекундах.
-};
-
-/**
- * @brief Класс для анимации, который наследует логику из AnimationLogic и добавляет графический интерфейс.
- */
-class Animation : private AnimationLogic
-{
-public:
-    /**
-     * @brief Конструктор по умолчанию.
-     */
-    explicit Animation(void) = default;
-
-    /**
-     * @brief Конструктор с параметрами.
-     * @param tex Текстура для анимации.
-     * @param n Количество спрайтов в текстуре.
-     * @param change_time Время смены спрайтов в миллисекундах.
-     */
-    explicit Animation(sf::Texture& tex, std::size_t n, int32_t change_time);
-
-    /**
-     * @brief Конструктор перемещения.
-     * @param other Другой объект Animation для перемещения.
-     */
-    explicit Animation(Animation&& other) noexcept = default;
-
-    /**
-     * @brief Оператор присваивания перемещением.
-     * @param other Другой объект Animation для присваивания.
-     * @return Ссылка на текущий объект Animation.
-     */
-    Animation& operator=(Animation&& other) noexcept = default;
-
-    /**
-     * @brief Деструктор.
-     */
-    ~Animation(void) override = default;
-
-    /**
-     * @brief Получить текущий спрайт на основе текущего времени. Изменяет m_is_running на false после демонстрации всех спрайтов.
-     * @param cur_time Текущее время в миллисекундах.
-     * @return Текущий спрайт.
-     */
-    sf::Sprite get_sprite(int32_t cur_time);
-
-    /**
-     * @brief Метод для возращения статуса нециклической анимации.
-     * @param cur_time Текущее время в миллисекундах.
-     * @return true если есть спрайт для этой анимации, иначе false
-     */
-    bool is_end(int32_t cur_time) const;
-
-    /**
-     * @brief Начать анимацию с начала.
-     */
-    void start(void);
-
-    /**
-     * @brief Изменить размер спрайтов анимации.
-     * @param new_size Новый размер.
-     */
-    void resize(const sf::Vector2f& new_size);
-
-private:
-    std::vector<sf::Sprite> m_sprites; ///< Вектор спрайтов для анимации.
-};
-
-#endif // ANIMATION_H
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <stdexcept>
+
+#include "animationscheduler.h"
+#include "framegeometry.h"
+#include "spritebatch.h"
+#include "textureatlas.h"
+
+/**
+ * @brief Класс для логики анимации, который не зависит от графического интерфейса.
+ *
+ * Хранит только время начала анимации: номер кадра вычисляется сразу из
+ * прошедшего времени, поэтому анимация, которую долго не рисовали
+ * (объект вне экрана или долгий кадр), сразу показывает верный кадр, а
+ * окончание определяется временем, а не частотой отрисовки.
+ */
+class AnimationLogic
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    AnimationLogic(void) = default;
+
+    /**
+     * @brief Конструктор с параметрами.
+     * @param n Количество спрайтов в анимации.
+     * @param change_time Время смены спрайтов в миллисекундах.
+     * @throw std::runtime_error при некорректных данных (n должно быть > 0 и change_time должно быть > 0)
+     */
+    AnimationLogic(std::size_t n, int32_t change_time);
+
+    /**
+     * @brief Конструктор перемещения.
+     * @param other Другой объект AnimationLogic для перемещения.
+     */
+    AnimationLogic(AnimationLogic&& other) noexcept = default;
+
+    /**
+     * @brief Виртуальный деструктор.
+     */
+    virtual ~AnimationLogic(void) = default;
+
+    /**
+     * @brief Оператор присваивания перемещением.
+     * @param other Другой объект AnimationLogic для присваивания.
+     * @return Ссылка на текущий объект AnimationLogic.
+     */
+    AnimationLogic& operator=(AnimationLogic&& other) noexcept = default;
+
+    /**
+     * @brief Метод для начала нециклической анимации с начала.
+     * @param cur_time Время начала в миллисекундах (-1 - время первого запроса кадра).
+     */
+    void start(int32_t cur_time = -1);
+
+    /**
+     * @brief Метод для возращения статуса нециклической анимации.
+     *
+     * Анимация закончилась, когда с начала прошло время показа всех кадров.
+     *
+     * @param cur_time Текущее время в миллисекундах.
+     * @return true если есть спрайт для этой анимации, иначе false
+     */
+    bool is_end(int32_t cur_time) const;
+
+    /**
+     * @brief Вычислить текущий индекс кадра на основе текущего времени.
+     *
+     * Если время начала не задано, анимация начинается в cur_time.
+     *
+     * @param cur_time Текущее время в миллисекундах.
+     * @return Индекс текущего спрайта.
+     */
+    std::size_t get_current_sprite_index(int32_t cur_time);
+
+protected:
+    /**
+     * @brief Время смены спрайтов.
+     * @return Время смены спрайтов в миллисекундах.
+     */
+    int32_t get_change_time(void) const;
+
+private:
+    /**
+     * @brief Количество смен кадра с начала анимации.
+     * @param cur_time Текущее время в миллисекундах.
+     * @return Количество смен кадра (0, если анимация не началась).
+     */
+    int32_t get_changes_count(int32_t cur_time) const;
+
+    std::size_t m_sprite_count;  ///< Количество спрайтов.
+    int32_t m_change_time;       ///< Время смены спрайта в миллисекундах.
+    int32_t m_start_time = -1;   ///< Время начала анимации в миллисекундах (-1 - еще не началась).
+};
+
+/**
+ * @brief Класс для анимации, который наследует логику из AnimationLogic и добавляет графический интерфейс.
+ */
+class Animation : private AnimationLogic
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit Animation(void) = default;
+
+    /**
+     * @brief Конструктор с параметрами.
+     *
+     * Кадры не копируются: все анимации одного типа объектов ссылаются на
+     * общую таблицу кадров, а сами хранят только состояние часов и размер.
+     *
+     * @param frames Таблица кадров анимации в атласе текстур (должна существовать, пока существует анимация).
+     * @param change_time Время смены спрайтов в миллисекундах.
+     */
+    explicit Animation(const std::vector<AtlasFrame>& frames, int32_t change_time);
+
+    /**
+     * @brief Конструктор перемещения.
+     * @param other Другой объект Animation для перемещения.
+     */
+    explicit Animation(Animation&& other) noexcept = default;
+
+    /**
+     * @brief Оператор присваивания перемещением.
+     * @param other Другой объект Animation для присваивания.
+     * @return Ссылка на текущий объект Animation.
+     */
+    Animation& operator=(Animation&& other) noexcept = default;
+
+    /**
+     * @brief Деструктор.
+     */
+    ~Animation(void) override = default;
+
+    /**
+     * @brief Получить текущий кадр на основе текущего времени.
+     * @param cur_time Текущее время в миллисекундах.
+     * @return Текущий кадр (текстура и прямоугольник в атласе).
+     */
+    const AtlasFrame& get_frame(int32_t cur_time);
+
+    /**
+     * @brief Размер, в котором отображаются кадры.
+     *
+     * Масштаб кадра - отношение этого размера к размеру прямоугольника кадра.
+     *
+     * @return Размер кадра на экране.
+     */
+    const sf::Vector2f& get_size(void) const;
+
+    /**
+     * @brief Добавляет текущий кадр в пакет отрисовки.
+     * @param batch Пакет отрисовки.
+     * @param layer Слой отрисовки.
+     * @param position Позиция левого верхнего угла кадра на экране.
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void draw(SpriteBatch& batch, SpriteBatch::Layer layer, const sf::Vector2f& position, int32_t cur_time);
+
+    /**
+     * @brief Записывает текущий кадр в массив вершин.
+     * @param vertices Куда добавить вершины.
+     * @param position Позиция левого верхнего угла кадра на экране.
+     * @param cur_time Текущее время в миллисекундах.
+     * @return Текстура кадра или nullptr, если кадр не загружен (тогда вершины не добавляются).
+     */
+    const sf::Texture* build(std::vector<sf::Vertex>& vertices, const sf::Vector2f& position, int32_t cur_time);
+
+    /**
+     * @brief Метод для возращения статуса нециклической анимации.
+     * @param cur_time Текущее время в миллисекундах.
+     * @return true если есть спрайт для этой анимации, иначе false
+     */
+    bool is_end(int32_t cur_time) const;
+
+    /**
+     * @brief Начать анимацию с начала.
+     * @param cur_time Время начала в миллисекундах (-1 - время первого запроса кадра).
+     */
+    void start(int32_t cur_time = -1);
+
+    /**
+     * @brief Изменить размер, в котором отображаются кадры.
+     *
+     * Вершины кадров в новом размере берутся из общего кэша при следующей
+     * отрисовке, поэтому повторное изменение размера почти ничего не стоит.
+     *
+     * @param new_size Новый размер.
+     */
+    void resize(const sf::Vector2f& new_size);
+
+    /**
+     * @brief Берет из кэша вершины кадров в текущем размере, не дожидаясь отрисовки.
+     *
+     * Позволяет заполнить кэш до начала игры, чтобы первая отрисовка
+     * объекта нового размера не выделяла память.
+     */
+    void prepare_geometry(void);
+
+    /**
+     * @brief Общий кэш вершин кадров всех анимаций.
+     *
+     * Очищается после пересборки атласа текстур, когда анимаций еще нет.
+     *
+     * @return Кэш вершин кадров.
+     */
+    static FrameGeometryCache& get_geometry_cache(void);
+
+    /**
+     * @brief Передает часы анимации планировщику и запускает ее.
+     *
+     * После этого номер кадра и окончание берутся из последнего вызова
+     * advance планировщика, а время, переданное в get_frame, draw, build
+     * и is_end, не используется.
+     *
+     * @param scheduler Планировщик (должен существовать, пока анимация в нем).
+     * @param looping Циклическая ли анимация.
+     * @param start_time Время начала в миллисекундах (-1 - остановить на первом кадре).
+     */
+    void schedule(AnimationScheduler& scheduler, bool looping, int32_t start_time);
+
+    /**
+     * @brief Удаляет анимацию из планировщика, часы снова становятся своими.
+     */
+    void unschedule(void);
+
+    /**
+     * @brief Проверяет, передана ли анимация планировщику.
+     * @return true, если анимация в планировщике, иначе false.
+     */
+    bool is_scheduled(void) const;
+
+    /**
+     * @brief Дескриптор анимации в планировщике (для сравнения с get_finished).
+     * @return Дескриптор (имеет смысл, только если is_scheduled).
+     */
+    AnimationScheduler::Handle get_handle(void) const;
+
+private:
+    /**
+     * @brief Номер текущего кадра.
+     * @param cur_time Текущее время в миллисекундах.
+     * @return Номер кадра в таблице.
+     */
+    std::size_t get_frame_index(int32_t cur_time);
+
+    /**
+     * @brief Вершины кадра в текущем размере от начала координат.
+     * @param index Номер кадра.
+     * @return Указатель на FrameGeometryCache::mc_frame_vertices вершин.
+     */
+    const sf::Vertex* get_frame_vertices(std::size_t index);
+
+    static FrameGeometryCache ms_geometry_cache; ///< Вершины кадров, общие для всех анимаций.
+
+    const std::vector<AtlasFrame>* m_frames = nullptr; ///< Общая таблица кадров анимации в атласе.
+    sf::Vector2f m_size; ///< Размер кадра на экране.
+    const std::vector<sf::Vertex>* m_geometry = nullptr; ///< Вершины кадров в текущем размере (nullptr - еще не взяты из кэша).
+    AnimationScheduler* m_scheduler = nullptr; ///< Планировщик, ведущий часы анимации (nullptr - часы свои).
+    AnimationScheduler::Handle m_handle = 0; ///< Дескриптор анимации в планировщике.
+};
+
+#endif // ANIMATION_H
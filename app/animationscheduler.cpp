@@ -0,0 +1,147 @@
+#include "animationscheduler.h"
+
+#include <algorithm>
+
+// Резервирование памяти
+void AnimationScheduler::reserve(std::size_t capacity)
+{
+    m_start_time.reserve(capacity);
+    m_change_time.reserve(capacity);
+    m_frame_count.reserve(capacity);
+    m_looping.reserve(capacity);
+    m_frame.reserve(capacity);
+    m_ended.reserve(capacity);
+    m_finished.reserve(capacity);
+    m_dense_to_handle.reserve(capacity);
+
+    m_handle_to_dense.reserve(capacity);
+    m_free_handles.reserve(capacity);
+    m_finished_now.reserve(capacity);
+}
+
+// Добавление анимации
+AnimationScheduler::Handle AnimationScheduler::add(std::size_t frame_count, int32_t change_time, bool looping,
+                                                   int32_t start_time)
+{
+    // Берем свободный дескриптор, если он есть, иначе заводим новый
+    Handle handle;
+    if (!m_free_handles.empty())
+    {
+        handle = m_free_handles.back();
+        m_free_handles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<Handle>(m_handle_to_dense.size());
+        m_handle_to_dense.push_back(0);
+    }
+
+    // Данные анимации добавляются в конец плотных массивов
+    m_handle_to_dense[handle] = static_cast<std::uint32_t>(m_start_time.size());
+    m_start_time.push_back(start_time);
+    m_change_time.push_back(change_time);
+    m_frame_count.push_back(static_cast<int32_t>(frame_count));
+    m_looping.push_back(looping ? 1 : 0);
+    m_frame.push_back(0);
+    m_ended.push_back(0);
+    m_finished.push_back(0);
+    m_dense_to_handle.push_back(handle);
+    return handle;
+}
+
+// Удаление анимации
+void AnimationScheduler::remove(Handle handle)
+{
+    // На место удаленной переносим последнюю анимацию, массивы остаются плотными
+    std::size_t index = m_handle_to_dense[handle];
+    std::size_t last = m_start_time.size() - 1;
+    if (index != last)
+    {
+        Handle moved = m_dense_to_handle[last];
+        m_start_time[index] = m_start_time[last];
+        m_change_time[index] = m_change_time[last];
+        m_frame_count[index] = m_frame_count[last];
+        m_looping[index] = m_looping[last];
+        m_frame[index] = m_frame[last];
+        m_ended[index] = m_ended[last];
+        m_finished[index] = m_finished[last];
+        m_dense_to_handle[index] = moved;
+        m_handle_to_dense[moved] = static_cast<std::uint32_t>(index);
+    }
+
+    m_start_time.pop_back();
+    m_change_time.pop_back();
+    m_frame_count.pop_back();
+    m_looping.pop_back();
+    m_frame.pop_back();
+    m_ended.pop_back();
+    m_finished.pop_back();
+    m_dense_to_handle.pop_back();
+    m_free_handles.push_back(handle);
+}
+
+// Перезапуск анимации
+void AnimationScheduler::restart(Handle handle, int32_t start_time)
+{
+    std::size_t index = m_handle_to_dense[handle];
+    m_start_time[index] = start_time;
+    m_frame[index] = 0;
+    m_ended[index] = 0;
+    m_finished[index] = 0;
+}
+
+// Продвижение всех анимаций
+void AnimationScheduler::advance(int32_t cur_time)
+{
+    std::size_t n = m_start_time.size();
+    const int32_t* start_time = m_start_time.data();
+    const int32_t* change_time = m_change_time.data();
+    const int32_t* frame_count = m_frame_count.data();
+    const std::uint8_t* looping = m_looping.data();
+    int32_t* frame = m_frame.data();
+    std::uint8_t* ended = m_ended.data();
+
+    // Номера кадров вычисляются без ветвлений, по массивам подряд
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int32_t is_started = start_time[i] != -1;
+        int32_t elapsed = std::max(0, cur_time - start_time[i]) * is_started;
+        int32_t changes = elapsed / change_time[i];
+        int32_t last_frame = frame_count[i] - 1;
+        frame[i] = looping[i] ? changes % frame_count[i] : std::min(changes, last_frame);
+        ended[i] = static_cast<std::uint8_t>(is_started & !looping[i] & (changes > last_frame));
+    }
+
+    // О закончившихся анимациях сообщаем один раз
+    m_finished_now.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (ended[i] && !m_finished[i])
+            m_finished_now.push_back(m_dense_to_handle[i]);
+        m_finished[i] = ended[i];
+    }
+}
+
+// Номер текущего кадра
+std::size_t AnimationScheduler::get_frame(Handle handle) const
+{
+    return static_cast<std::size_t>(m_frame[m_handle_to_dense[handle]]);
+}
+
+// Окончание анимации
+bool AnimationScheduler::is_finished(Handle handle) const
+{
+    return m_finished[m_handle_to_dense[handle]] != 0;
+}
+
+// Закончившиеся анимации
+const std::vector<AnimationScheduler::Handle>& AnimationScheduler::get_finished(void) const
+{
+    return m_finished_now;
+}
+
+// Количество анимаций
+std::size_t AnimationScheduler::size(void) const
+{
+    return m_start_time.size();
+}
@@ -0,0 +1,112 @@
+#ifndef ANIMATIONSCHEDULER_H
+#define ANIMATIONSCHEDULER_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Общие часы всех живых анимаций.
+ *
+ * Время начала, время смены и количество кадров каждой анимации хранятся
+ * в плотно упакованных массивах. Раз в кадр advance одним проходом
+ * вычисляет номера текущих кадров всех анимаций, а отрисовка потом только
+ * читает готовые номера. Нециклические анимации, закончившиеся в этом
+ * кадре, попадают в список get_finished, поэтому опрашивать каждую
+ * анимацию не нужно.
+ *
+ * Дескриптор анимации не меняется, пока она не удалена, хотя при удалении
+ * других анимаций ее данные могут переместиться внутри массивов.
+ */
+class AnimationScheduler
+{
+public:
+    using Handle = std::uint32_t; ///< Дескриптор анимации.
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit AnimationScheduler(void) = default;
+
+    /**
+     * @brief Резервирует память под заданное количество анимаций.
+     * @param capacity Ожидаемое количество одновременно живых анимаций.
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Добавляет анимацию.
+     * @param frame_count Количество кадров (больше нуля).
+     * @param change_time Время смены кадров в миллисекундах (больше нуля).
+     * @param looping Циклическая ли анимация.
+     * @param start_time Время начала в миллисекундах (-1 - анимация остановлена на первом кадре).
+     * @return Дескриптор анимации.
+     */
+    Handle add(std::size_t frame_count, int32_t change_time, bool looping, int32_t start_time);
+
+    /**
+     * @brief Удаляет анимацию. Дескриптор после этого использовать нельзя.
+     * @param handle Дескриптор анимации.
+     */
+    void remove(Handle handle);
+
+    /**
+     * @brief Запускает анимацию с начала.
+     *
+     * Номер кадра сразу становится первым, а пометка окончания снимается.
+     *
+     * @param handle Дескриптор анимации.
+     * @param start_time Время начала в миллисекундах (-1 - остановить на первом кадре).
+     */
+    void restart(Handle handle, int32_t start_time);
+
+    /**
+     * @brief Продвигает все анимации к заданному времени.
+     *
+     * Список закончившихся анимаций заполняется заново.
+     *
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void advance(int32_t cur_time);
+
+    /**
+     * @brief Номер текущего кадра анимации, вычисленный последним advance.
+     * @param handle Дескриптор анимации.
+     * @return Номер кадра.
+     */
+    std::size_t get_frame(Handle handle) const;
+
+    /**
+     * @brief Показаны ли все кадры нециклической анимации.
+     * @param handle Дескриптор анимации.
+     * @return true, если анимация закончилась, иначе false.
+     */
+    bool is_finished(Handle handle) const;
+
+    /**
+     * @brief Нециклические анимации, закончившиеся при последнем advance.
+     * @return Дескрипторы анимаций.
+     */
+    const std::vector<Handle>& get_finished(void) const;
+
+    /**
+     * @brief Количество живых анимаций.
+     * @return Количество анимаций.
+     */
+    std::size_t size(void) const;
+
+private:
+    std::vector<int32_t> m_start_time;   ///< Время начала (-1 - анимация остановлена).
+    std::vector<int32_t> m_change_time;  ///< Время смены кадров.
+    std::vector<int32_t> m_frame_count;  ///< Количество кадров.
+    std::vector<std::uint8_t> m_looping; ///< Флаг циклической анимации.
+    std::vector<int32_t> m_frame;        ///< Номер текущего кадра.
+    std::vector<std::uint8_t> m_ended;   ///< Флаг окончания, вычисленный advance.
+    std::vector<std::uint8_t> m_finished; ///< Флаг окончания, о котором уже сообщено.
+    std::vector<Handle> m_dense_to_handle; ///< Дескриптор по плотному индексу.
+
+    std::vector<std::uint32_t> m_handle_to_dense; ///< Плотный индекс по дескриптору.
+    std::vector<Handle> m_free_handles;           ///< Свободные дескрипторы для повторного использования.
+    std::vector<Handle> m_finished_now;           ///< Анимации, закончившиеся при последнем advance.
+};
+
+#endif // ANIMATIONSCHEDULER_H
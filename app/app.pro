@@ -1,28 +1,46 @@
 TEMPLATE = app
 CONFIG += console
+CONFIG += thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES +=  \
+    alloccounter.cpp \
     gamelabels.cpp \
     gameobjects.cpp \
+    glyphfont.cpp \
     gamerenderer.cpp \
 #    gamescreen.cpp \
     label.cpp \
     main.cpp \
     animation.cpp \
+    animationscheduler.cpp \
+    assetpack.cpp \
+    framegeometry.cpp \
     number.cpp \
-    object.cpp
+    object.cpp \
+    spritebatch.cpp \
+    textureatlas.cpp \
+    vertexstream.cpp
 
 HEADERS +=  \
+    alloccounter.h \
     animation.h \
+    animationscheduler.h \
+    assetpack.h \
+    framegeometry.h \
     gamelabels.h \
     gameobjects.h \
+    glyphfont.h \
     gamerenderer.h \
 #    gamescreen.h \
     label.h \
     number.h \
-    object.h
+    object.h \
+    objectpool.h \
+    spritebatch.h \
+    textureatlas.h \
+    vertexstream.h
 
 QMAKE_CXXFLAGS += -Wall -Wextra -Werror
 
@@ -30,6 +48,11 @@ QMAKE_CXXFLAGS += -Wall -Wextra -Werror
 QMAKE_CXXFLAGS += -fprofile-arcs -ftest-coverage -O0
 LIBS += -lgcov
 
+# библиотека симуляции матча
+INCLUDEPATH += ../core
+LIBS += -L../core -lblumcore
+PRE_TARGETDEPS += ../core/libblumcore.a
+
 # путь к заголовочным файлам SFML
 INCLUDEPATH += /usr/include
 
@@ -0,0 +1,301 @@
+#include "assetpack.h"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char c_magic[8] = {'B', 'L', 'U', 'M', 'P', 'A', 'C', 'K'}; // Сигнатура пака
+    constexpr std::uint32_t c_version = 1;   // Версия формата
+    constexpr std::size_t c_pixel_align = 16; // Выравнивание пикселей страниц
+
+    /**
+     * @brief Заголовок пака.
+     */
+    struct Header
+    {
+        char magic[8];              ///< Сигнатура.
+        std::uint32_t version;      ///< Версия формата.
+        std::uint32_t page_count;   ///< Количество страниц.
+        std::uint32_t strip_count;  ///< Количество полос.
+        std::uint32_t data_count;   ///< Количество блоков данных.
+    };
+
+    /**
+     * @brief Запись о странице.
+     */
+    struct PageRecord
+    {
+        std::uint32_t width;   ///< Ширина.
+        std::uint32_t height;  ///< Высота.
+        std::uint64_t offset;  ///< Смещение пикселей от начала файла.
+    };
+
+    /**
+     * @brief Запись оглавления (полоса или блок данных).
+     */
+    struct IndexRecord
+    {
+        std::uint64_t name_offset; ///< Смещение имени.
+        std::uint32_t name_size;   ///< Длина имени.
+        std::uint32_t count;       ///< Количество кадров или байт.
+        std::uint64_t offset;      ///< Смещение содержимого.
+    };
+
+    static_assert(std::is_trivially_copyable<AssetPack::Frame>::value && sizeof(AssetPack::Frame) == 20,
+                  "AssetPack::Frame is stored in the pack as is");
+
+    // Добавление байт в конец файла
+    std::uint64_t append(std::vector<char>& file, const void* bytes, std::size_t size)
+    {
+        std::uint64_t offset = file.size();
+        const char* begin = static_cast<const char*>(bytes);
+        file.insert(file.end(), begin, begin + size);
+        return offset;
+    }
+
+    // Дополнение файла нулями до границы выравнивания
+    void align(std::vector<char>& file, std::size_t alignment)
+    {
+        file.resize((file.size() + alignment - 1) / alignment * alignment, 0);
+    }
+
+    // Проверка, что диапазон лежит внутри файла
+    bool is_inside(std::uint64_t offset, std::uint64_t size, std::size_t file_size)
+    {
+        return offset <= file_size && size <= file_size - offset;
+    }
+}
+
+// Деструктор класса AssetPack
+AssetPack::~AssetPack(void)
+{
+    close();
+}
+
+// Запись пака
+bool AssetPack::write(const std::string& path, const std::vector<sf::Image>& pages, const std::vector<Strip>& strips,
+                      const std::vector<Data>& data)
+{
+    Header header;
+    std::memcpy(header.magic, c_magic, sizeof(c_magic));
+    header.version = c_version;
+    header.page_count = static_cast<std::uint32_t>(pages.size());
+    header.strip_count = static_cast<std::uint32_t>(strips.size());
+    header.data_count = static_cast<std::uint32_t>(data.size());
+
+    // Оглавление заполняется после того, как станут известны смещения содержимого
+    std::vector<PageRecord> page_records(pages.size());
+    std::vector<IndexRecord> strip_records(strips.size());
+    std::vector<IndexRecord> data_records(data.size());
+
+    std::vector<char> file;
+    append(file, &header, sizeof(header));
+    std::size_t page_table = append(file, page_records.data(), page_records.size() * sizeof(PageRecord));
+    std::size_t strip_table = append(file, strip_records.data(), strip_records.size() * sizeof(IndexRecord));
+    std::size_t data_table = append(file, data_records.data(), data_records.size() * sizeof(IndexRecord));
+
+    for (std::size_t i = 0; i < strips.size(); ++i)
+    {
+        strip_records[i].name_offset = append(file, strips[i].name.data(), strips[i].name.size());
+        strip_records[i].name_size = static_cast<std::uint32_t>(strips[i].name.size());
+        align(file, alignof(Frame));
+        strip_records[i].count = static_cast<std::uint32_t>(strips[i].frames.size());
+        strip_records[i].offset = append(file, strips[i].frames.data(), strips[i].frames.size() * sizeof(Frame));
+    }
+
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        data_records[i].name_offset = append(file, data[i].name.data(), data[i].name.size());
+        data_records[i].name_size = static_cast<std::uint32_t>(data[i].name.size());
+        align(file, alignof(std::uint64_t));
+        data_records[i].count = static_cast<std::uint32_t>(data[i].bytes.size());
+        data_records[i].offset = append(file, data[i].bytes.data(), data[i].bytes.size());
+    }
+
+    // Пиксели страниц - в конце файла, выровненными, чтобы загружать их прямо из отображения
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        sf::Vector2u size = pages[i].getSize();
+        align(file, c_pixel_align);
+        page_records[i].width = size.x;
+        page_records[i].height = size.y;
+        page_records[i].offset = append(file, pages[i].getPixelsPtr(), static_cast<std::size_t>(size.x) * size.y * 4);
+    }
+
+    std::memcpy(&file[page_table], page_records.data(), page_records.size() * sizeof(PageRecord));
+    std::memcpy(&file[strip_table], strip_records.data(), strip_records.size() * sizeof(IndexRecord));
+    std::memcpy(&file[data_table], data_records.data(), data_records.size() * sizeof(IndexRecord));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(file.data(), static_cast<std::streamsize>(file.size()));
+    return static_cast<bool>(out);
+}
+
+// Открытие пака
+bool AssetPack::open(const std::string& path)
+{
+    close();
+
+#ifndef _WIN32
+    // Файл отображается в память: страницы читаются с диска только при загрузке в видеопамять
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            m_bytes = static_cast<const char*>(mapping);
+            m_size = static_cast<std::size_t>(info.st_size);
+            m_is_mapped = true;
+        }
+    }
+    ::close(fd);
+#else
+    // Без mmap файл читается целиком одним вызовом
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (in)
+    {
+        m_buffer.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        if (in.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size())) && !m_buffer.empty())
+        {
+            m_bytes = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+    }
+#endif
+
+    if (m_bytes == nullptr || !read_index())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Закрытие пака
+void AssetPack::close(void)
+{
+#ifndef _WIN32
+    if (m_is_mapped)
+        ::munmap(const_cast<char*>(m_bytes), m_size);
+#endif
+    m_bytes = nullptr;
+    m_size = 0;
+    m_is_mapped = false;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+
+    m_page_sizes.clear();
+    m_page_pixels.clear();
+    m_strips.clear();
+    m_data.clear();
+}
+
+// Открыт ли пак
+bool AssetPack::is_open(void) const
+{
+    return m_bytes != nullptr;
+}
+
+// Размер файла
+std::size_t AssetPack::get_size(void) const
+{
+    return m_size;
+}
+
+// Количество страниц
+std::size_t AssetPack::get_page_count(void) const
+{
+    return m_page_sizes.size();
+}
+
+// Размер страницы
+sf::Vector2u AssetPack::get_page_size(std::size_t index) const
+{
+    return m_page_sizes[index];
+}
+
+// Пиксели страницы
+const std::uint8_t* AssetPack::get_page_pixels(std::size_t index) const
+{
+    return m_page_pixels[index];
+}
+
+// Поиск полосы кадров
+const AssetPack::Frame* AssetPack::find_strip(const std::string& name, std::size_t& count) const
+{
+    auto found = m_strips.find(name);
+    if (found == m_strips.end())
+        return nullptr;
+    count = found->second.count;
+    return reinterpret_cast<const Frame*>(found->second.bytes);
+}
+
+// Поиск блока данных
+const char* AssetPack::find_data(const std::string& name, std::size_t& size) const
+{
+    auto found = m_data.find(name);
+    if (found == m_data.end())
+        return nullptr;
+    size = found->second.count;
+    return found->second.bytes;
+}
+
+// Чтение оглавления
+bool AssetPack::read_index(void)
+{
+    Header header;
+    if (m_size < sizeof(header))
+        return false;
+    std::memcpy(&header, m_bytes, sizeof(header));
+    if (std::memcmp(header.magic, c_magic, sizeof(c_magic)) != 0 || header.version != c_version)
+        return false;
+
+    std::uint64_t tables_size = header.page_count * sizeof(PageRecord) +
+            (static_cast<std::uint64_t>(header.strip_count) + header.data_count) * sizeof(IndexRecord);
+    if (!is_inside(sizeof(header), tables_size, m_size))
+        return false;
+
+    const char* cursor = m_bytes + sizeof(header);
+    for (std::uint32_t i = 0; i < header.page_count; ++i, cursor += sizeof(PageRecord))
+    {
+        PageRecord record;
+        std::memcpy(&record, cursor, sizeof(record));
+        if (!is_inside(record.offset, static_cast<std::uint64_t>(record.width) * record.height * 4, m_size))
+            return false;
+        m_page_sizes.emplace_back(record.width, record.height);
+        m_page_pixels.push_back(reinterpret_cast<const std::uint8_t*>(m_bytes + record.offset));
+    }
+
+    // Полосы и блоки данных записаны одинаково, отличается только размер элемента
+    for (std::uint32_t i = 0; i < header.strip_count + header.data_count; ++i, cursor += sizeof(IndexRecord))
+    {
+        IndexRecord record;
+        std::memcpy(&record, cursor, sizeof(record));
+        bool is_strip = i < header.strip_count;
+        std::uint64_t size = static_cast<std::uint64_t>(record.count) * (is_strip ? sizeof(Frame) : 1);
+        if (!is_inside(record.name_offset, record.name_size, m_size) || !is_inside(record.offset, size, m_size))
+            return false;
+        if (is_strip && record.offset % alignof(Frame) != 0)
+            return false;
+
+        std::string name(m_bytes + record.name_offset, record.name_size);
+        Entry entry{m_bytes + record.offset, record.count};
+        (is_strip ? m_strips : m_data).emplace(std::move(name), entry);
+    }
+    return true;
+}
@@ -0,0 +1,175 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Заранее собранный файл ресурсов (пак), отображаемый в память.
+ *
+ * Пак собирается заранее (см. packer) из тех же картинок и шрифтов, что
+ * игра загружает при запуске, и содержит:
+ * - страницы атласа текстур - уже декодированные пиксели RGBA;
+ * - полосы кадров - имя полосы (путь к картинке) и прямоугольники ее кадров
+ *   на страницах;
+ * - именованные блоки данных (например, размеры символов шрифта).
+ *
+ * При открытии файл отображается в память (mmap), а страницы загружаются
+ * в видеопамять прямо из отображения, без декодирования PNG и чтения
+ * отдельных файлов. Указатели, которые возвращает пак, действительны до
+ * close или разрушения пака.
+ *
+ * Числа хранятся в порядке байт машины, на которой собран пак; пак другой
+ * версии или поврежденный пак не открывается.
+ */
+class AssetPack
+{
+public:
+    /**
+     * @brief Кадр полосы в паке.
+     */
+    struct Frame
+    {
+        int32_t page;   ///< Номер страницы (-1 - кадр не загружен).
+        int32_t left;   ///< Левый край на странице.
+        int32_t top;    ///< Верхний край на странице.
+        int32_t width;  ///< Ширина.
+        int32_t height; ///< Высота.
+    };
+
+    /**
+     * @brief Полоса кадров для записи в пак.
+     */
+    struct Strip
+    {
+        std::string name;          ///< Имя полосы (путь к картинке).
+        std::vector<Frame> frames; ///< Кадры полосы.
+    };
+
+    /**
+     * @brief Блок данных для записи в пак.
+     */
+    struct Data
+    {
+        std::string name;       ///< Имя блока.
+        std::vector<char> bytes; ///< Содержимое блока.
+    };
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit AssetPack(void) = default;
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief Деструктор, закрывает пак.
+     */
+    ~AssetPack(void);
+
+    /**
+     * @brief Записывает пак в файл.
+     * @param path Путь к файлу.
+     * @param pages Страницы атласа.
+     * @param strips Полосы кадров.
+     * @param data Блоки данных.
+     * @return true, если файл записан, иначе false.
+     */
+    static bool write(const std::string& path, const std::vector<sf::Image>& pages, const std::vector<Strip>& strips,
+                      const std::vector<Data>& data);
+
+    /**
+     * @brief Отображает пак в память и читает его оглавление.
+     *
+     * Открытый ранее пак закрывается.
+     *
+     * @param path Путь к файлу.
+     * @return true, если пак открыт, false, если файла нет или он поврежден.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Закрывает пак и освобождает отображение.
+     */
+    void close(void);
+
+    /**
+     * @brief Проверяет, открыт ли пак.
+     * @return true, если пак открыт, иначе false.
+     */
+    bool is_open(void) const;
+
+    /**
+     * @brief Размер файла пака.
+     * @return Размер в байтах (0, если пак не открыт).
+     */
+    std::size_t get_size(void) const;
+
+    /**
+     * @brief Количество страниц атласа.
+     * @return Количество страниц.
+     */
+    std::size_t get_page_count(void) const;
+
+    /**
+     * @brief Размер страницы атласа.
+     * @param index Номер страницы.
+     * @return Ширина и высота в пикселях.
+     */
+    sf::Vector2u get_page_size(std::size_t index) const;
+
+    /**
+     * @brief Пиксели страницы атласа.
+     * @param index Номер страницы.
+     * @return Пиксели RGBA построчно (ширина * высота * 4 байт).
+     */
+    const std::uint8_t* get_page_pixels(std::size_t index) const;
+
+    /**
+     * @brief Находит полосу кадров.
+     * @param name Имя полосы.
+     * @param count Куда записать количество кадров.
+     * @return Кадры полосы или nullptr, если полосы нет.
+     */
+    const Frame* find_strip(const std::string& name, std::size_t& count) const;
+
+    /**
+     * @brief Находит блок данных.
+     * @param name Имя блока.
+     * @param size Куда записать размер блока.
+     * @return Содержимое блока или nullptr, если блока нет.
+     */
+    const char* find_data(const std::string& name, std::size_t& size) const;
+
+private:
+    /**
+     * @brief Запись оглавления: где в файле лежит полоса или блок данных.
+     */
+    struct Entry
+    {
+        const char* bytes = nullptr; ///< Начало содержимого.
+        std::size_t count = 0;       ///< Количество кадров (для полосы) или байт (для блока данных).
+    };
+
+    /**
+     * @brief Читает оглавление отображенного файла.
+     * @return true, если оглавление корректно, иначе false.
+     */
+    bool read_index(void);
+
+    const char* m_bytes = nullptr; ///< Начало отображения (или прочитанного файла).
+    std::size_t m_size = 0;        ///< Размер файла.
+    bool m_is_mapped = false;      ///< Отображен ли файл через mmap (иначе прочитан в m_buffer).
+    std::vector<char> m_buffer;    ///< Содержимое файла, если отображение недоступно.
+
+    std::vector<sf::Vector2u> m_page_sizes;           ///< Размеры страниц.
+    std::vector<const std::uint8_t*> m_page_pixels;   ///< Пиксели страниц.
+    std::unordered_map<std::string, Entry> m_strips;  ///< Полосы кадров по именам.
+    std::unordered_map<std::string, Entry> m_data;    ///< Блоки данных по именам.
+};
+
+#endif // ASSETPACK_H
@@ -0,0 +1,50 @@
+#include "framegeometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "spritebatch.h"
+
+// Вершины кадров в заданном размере
+const std::vector<sf::Vertex>& FrameGeometryCache::get(const std::vector<AtlasFrame>& frames, const sf::Vector2f& size)
+{
+    sf::Vector2f rounded = round_size(size);
+    Key key{&frames, static_cast<int32_t>(rounded.x), static_cast<int32_t>(rounded.y)};
+
+    auto found = m_entries.find(key);
+    if (found != m_entries.end())
+        return found->second;
+
+    // Кадры строятся от начала координат, при отрисовке они сдвигаются на позицию объекта
+    std::vector<sf::Vertex>& vertices = m_entries[key];
+    vertices.reserve(frames.size() * mc_frame_vertices);
+    for (const AtlasFrame& frame : frames)
+        SpriteBatch::append_quad(vertices, sf::FloatRect(sf::Vector2f(), rounded), frame.rect);
+    ++m_misses;
+    return vertices;
+}
+
+// Округление размера
+sf::Vector2f FrameGeometryCache::round_size(const sf::Vector2f& size)
+{
+    return sf::Vector2f(std::max(1.f, std::round(size.x)), std::max(1.f, std::round(size.y)));
+}
+
+// Очистка кэша
+void FrameGeometryCache::clear(void)
+{
+    m_entries.clear();
+    m_misses = 0;
+}
+
+// Количество записей
+std::size_t FrameGeometryCache::size(void) const
+{
+    return m_entries.size();
+}
+
+// Количество промахов
+std::size_t FrameGeometryCache::get_miss_count(void) const
+{
+    return m_misses;
+}
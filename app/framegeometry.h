@@ -0,0 +1,107 @@
+#ifndef FRAMEGEOMETRY_H
+#define FRAMEGEOMETRY_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "textureatlas.h"
+
+/**
+ * @brief Общий кэш вершин кадров анимаций в заданном размере.
+ *
+ * Для пары (таблица кадров, размер на экране) один раз строятся вершины
+ * всех кадров - по шесть на кадр, от левого верхнего угла (0, 0). При
+ * отрисовке остается только сдвинуть их на позицию объекта. Размер
+ * округляется до целых пикселей, поэтому объекты близкого размера и
+ * повторные изменения размера используют одну и ту же запись.
+ *
+ * Записи не удаляются и не перемещаются, пока не вызван clear, поэтому
+ * на них можно хранить указатели. После пересборки атласа (таблицы
+ * кадров меняются) кэш нужно очистить.
+ */
+class FrameGeometryCache
+{
+public:
+    static constexpr std::size_t mc_frame_vertices = 6; ///< Количество вершин одного кадра.
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit FrameGeometryCache(void) = default;
+
+    FrameGeometryCache(const FrameGeometryCache&) = delete;
+    FrameGeometryCache& operator=(const FrameGeometryCache&) = delete;
+
+    /**
+     * @brief Вершины всех кадров таблицы в заданном размере.
+     *
+     * Запись строится при первом запросе, дальше берется из кэша.
+     *
+     * @param frames Таблица кадров.
+     * @param size Размер кадра на экране.
+     * @return Вершины кадров (кадр i - вершины с i * mc_frame_vertices).
+     */
+    const std::vector<sf::Vertex>& get(const std::vector<AtlasFrame>& frames, const sf::Vector2f& size);
+
+    /**
+     * @brief Размер, в котором кадры хранятся в кэше.
+     * @param size Размер кадра на экране.
+     * @return Размер, округленный до целых пикселей (не меньше одного).
+     */
+    static sf::Vector2f round_size(const sf::Vector2f& size);
+
+    /**
+     * @brief Удаляет все записи. Указатели на них становятся недействительными.
+     */
+    void clear(void);
+
+    /**
+     * @brief Количество записей.
+     * @return Количество пар (таблица кадров, размер).
+     */
+    std::size_t size(void) const;
+
+    /**
+     * @brief Количество построенных записей с последнего clear.
+     * @return Количество промахов кэша.
+     */
+    std::size_t get_miss_count(void) const;
+
+private:
+    /**
+     * @brief Ключ записи: таблица кадров и округленный размер.
+     */
+    struct Key
+    {
+        const std::vector<AtlasFrame>* frames; ///< Таблица кадров.
+        int32_t width;                         ///< Ширина в пикселях.
+        int32_t height;                        ///< Высота в пикселях.
+
+        bool operator==(const Key& other) const
+        {
+            return frames == other.frames && width == other.width && height == other.height;
+        }
+    };
+
+    /**
+     * @brief Хэш ключа записи.
+     */
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<const void*>()(key.frames);
+            hash ^= std::hash<int32_t>()(key.width) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<int32_t>()(key.height) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    std::unordered_map<Key, std::vector<sf::Vertex>, KeyHash> m_entries; ///< Записи кэша.
+    std::size_t m_misses = 0; ///< Количество построенных записей.
+};
+
+#endif // FRAMEGEOMETRY_H
@@ -1,18 +1,21 @@
 #include "gamelabels.h"
 
+#include <algorithm>
+#include <cstdio>
+
 // =======================================================
 // ===================== Timer label =====================
 // =======================================================
 
 // Инициализация статических членов класса TimerLabel
-sf::Texture TimerLabel::ms_timer_idle_anim_tex;
-sf::Texture TimerLabel::ms_timer_ice_anim_tex;
-sf::Font TimerLabel::ms_timer_font;
+std::vector<AtlasFrame> TimerLabel::ms_timer_idle_frames;
+std::vector<AtlasFrame> TimerLabel::ms_timer_ice_frames;
+GlyphFont TimerLabel::ms_timer_font;
 
 // Конструктор с параметром для инициализации игровой доски
 TimerLabel::TimerLabel(const sf::FloatRect& game_board)
-    : m_label_idle(ms_timer_idle_anim_tex, 1, 1000, ms_timer_font),
-      m_label_ice(ms_timer_ice_anim_tex, 1, 1000, ms_timer_font),
+    : m_label_idle(ms_timer_idle_frames, 1000, ms_timer_font),
+      m_label_ice(ms_timer_ice_frames, 1000, ms_timer_font),
       m_game_board(game_board)
 {
     // устанавливаем начальные настройи для меток
@@ -31,13 +34,20 @@ void TimerLabel::ice(void)
 // Установка текущего времени
 void TimerLabel::set_time(int32_t cur_time)
 {
+    // Строку пересобираем только при смене отображаемого значения,
+    // чтобы не выделять память в каждом кадре
+    if (cur_time == m_cur_time)
+        return;
+    m_cur_time = cur_time;
+
     // устанавливаем текущее время
-    std::string timer_str = format_seconds(cur_time);
+    char timer_str[Label::mc_max_string_length + 1];
+    format_seconds(cur_time, timer_str, sizeof(timer_str));
     m_label_idle.set_string(timer_str);
     m_label_ice.set_string(timer_str);
 }
 
-void TimerLabel::draw(sf::RenderWindow &window, int32_t cur_time)
+void TimerLabel::draw(SpriteBatch& batch, int32_t cur_time)
 {
     ///< Проверяем события
     if (m_is_ice)// Был активирован лед
@@ -50,12 +60,12 @@ void TimerLabel::draw(sf::RenderWindow &window, int32_t cur_time)
     if (m_start_ice_time != -1 &&
             cur_time - m_start_ice_time <= mc_ice_time)
     {
-        m_label_ice.draw(window, cur_time);
+        m_label_ice.draw(batch, cur_time);
     }
     // мы отображаем обычный таймер
     else
     {
-        m_label_idle.draw(window, cur_time);
+        m_label_idle.draw(batch, cur_time);
     }
 
     // сбрасываем флаг
@@ -63,31 +73,28 @@ void TimerLabel::draw(sf::RenderWindow &window, int32_t cur_time)
 }
 
 // Форматирование времени в строку формата "MM:SS"
-std::string TimerLabel::format_seconds(int seconds) const
+void TimerLabel::format_seconds(int seconds, char* buffer, std::size_t size) const
 {
     int minutes = seconds / 60;
     int remainingSeconds = seconds % 60;
 
-    std::ostringstream oss;
-    oss << std::setw(2) << std::setfill('0') << minutes << ":"
-        << std::setw(2) << std::setfill('0') << remainingSeconds;
-
-    return oss.str();
+    // Запись в готовый буфер, без выделения памяти
+    std::snprintf(buffer, size, "%02d:%02d", minutes, remainingSeconds);
 }
 
 // Загрузка ресурсов (текстуры и шрифта) для метки времени
-bool TimerLabel::load_resources(void)
+bool TimerLabel::load_resources(TextureAtlas& atlas)
 {
     bool success = true;
-    // Загрузка текстуры
-    if (!ms_timer_idle_anim_tex.loadFromFile("./src/timer_bg.png"))
+    // Загрузка картинок в атлас
+    if (!atlas.add_strip("./src/timer_bg.png", 1, ms_timer_idle_frames))
         success = false;
 
-    if (!ms_timer_ice_anim_tex.loadFromFile("./src/timer_ice_bg.png"))
+    if (!atlas.add_strip("./src/timer_ice_bg.png", 1, ms_timer_ice_frames))
         success = false;
 
-    // Загрузка шрифта
-    if (!ms_timer_font.loadFromFile("./src/Consolas.ttf"))
+    // Растеризация символов шрифта (жирным) в атлас
+    if (!ms_timer_font.load(atlas, "./src/Consolas.ttf", mc_font_size, true))
         success = false;
 
     return success;
@@ -117,7 +124,7 @@ float TimerLabel::calc_pic_y_position(void) const
 void TimerLabel::label_settings(Label& label)
 {
     // Установка начальных параметров для текста
-    label.set_string_settings(sf::Color::Yellow, mc_font_size, sf::Text::Bold);
+    label.set_string_settings(sf::Color::Yellow, mc_font_size);
 
     // Установка начальных значений для картинок
     label.set_picture_size(sf::Vector2f(mc_picture_size_w, mc_picture_size_h));
@@ -139,20 +146,20 @@ void TimerLabel::label_settings(Label& label)
 // =======================================================
 
 // Инициализация статических членов класса ScoreLabel
-sf::Texture ScoreLabel::ms_score_idle_anim_tex;
-sf::Texture ScoreLabel::ms_score_boom_anim_tex;
-sf::Font ScoreLabel::ms_score_font;
+std::vector<AtlasFrame> ScoreLabel::ms_score_idle_frames;
+std::vector<AtlasFrame> ScoreLabel::ms_score_boom_frames;
+GlyphFont ScoreLabel::ms_score_font;
 
 
 // Конструктор с параметром для инициализации игровой доски
 ScoreLabel::ScoreLabel(const sf::FloatRect& game_board)
-    : m_label_idle(ms_score_idle_anim_tex, 1, 1000, ms_score_font),
-      m_label_boom(ms_score_boom_anim_tex, 1, 1000, ms_score_font),
+    : m_label_idle(ms_score_idle_frames, 1000, ms_score_font),
+      m_label_boom(ms_score_boom_frames, 1000, ms_score_font),
       m_game_board(game_board)
 {
     // Установка начальных параметров для текста
-    m_label_idle.set_string_settings(sf::Color::White, mc_font_size, sf::Text::Bold);
-    m_label_boom.set_string_settings(sf::Color::Red,   mc_font_size, sf::Text::Bold);
+    m_label_idle.set_string_settings(sf::Color::White, mc_font_size);
+    m_label_boom.set_string_settings(sf::Color::Red,   mc_font_size);
 }
 
 // Установка текущего счета
@@ -163,8 +170,9 @@ void ScoreLabel::set_score(std::size_t cur_score)
         m_is_score_changed = true;
         m_prev_score = cur_score;
 
-        // Устанавливаем новый результат
-        std::string cur_str_res = std::to_string(cur_score);
+        // Устанавливаем новый результат (запись в буфер на стеке, без выделения памяти)
+        char cur_str_res[Label::mc_max_string_length + 1];
+        std::snprintf(cur_str_res, sizeof(cur_str_res), "%zu", cur_score);
 
         m_label_idle.set_string(cur_str_res);
         m_label_boom.set_string(cur_str_res);
@@ -181,7 +189,7 @@ void ScoreLabel::boom(void)
     m_is_boom = true;
 }
 
-void ScoreLabel::draw(sf::RenderWindow& window, int32_t cur_time)
+void ScoreLabel::draw(SpriteBatch& batch, int32_t cur_time)
 {
     ///<  Обрабатываем различные сценарии отображения (бомба и(или) заработок)
     // Если значение счета с предыдущего раза поменялось => засекаем время начала увеличения
@@ -214,22 +222,24 @@ void ScoreLabel::draw(sf::RenderWindow& window, int32_t cur_time)
     if (m_start_boom_time != -1 &&
             cur_time - m_start_boom_time <= mc_boom_time)
     {
-        // обновляем размер и позицию картинки в соответсвии с размером шрифта
+        // обновляем размер и позицию картинки в соответсвии с размером шрифта (если текст изменился)
         m_label_boom.set_string_scale(m_cur_increase_cof);
-        update_picture(m_label_boom);
+        if (m_label_boom.is_changed())
+            update_picture(m_label_boom);
 
         // отображаем результат
-        m_label_boom.draw(window, cur_time);
+        m_label_boom.draw(batch, cur_time);
 
     }
     else // метка должна быть обычной
     {
-        // обновляем размер и позицию картинки в соответсвии с размером шрифта
+        // обновляем размер и позицию картинки в соответсвии с размером шрифта (если текст изменился)
         m_label_idle.set_string_scale(m_cur_increase_cof);
-        update_picture(m_label_idle);
+        if (m_label_idle.is_changed())
+            update_picture(m_label_idle);
 
         // отображаем результат
-        m_label_idle.draw(window, cur_time);
+        m_label_idle.draw(batch, cur_time);
     }
 
     // опускаем все флаги
@@ -238,18 +248,18 @@ void ScoreLabel::draw(sf::RenderWindow& window, int32_t cur_time)
 }
 
 // Загрузка ресурсов (текстуры и шрифта) для метки счета
-bool ScoreLabel::load_resources(void)
+bool ScoreLabel::load_resources(TextureAtlas& atlas)
 {
     bool success = true;
-    // Загрузка текстур
-    if (!ms_score_idle_anim_tex.loadFromFile("./src/blum_sign.png"))
+    // Загрузка картинок в атлас
+    if (!atlas.add_strip("./src/blum_sign.png", 1, ms_score_idle_frames))
         success = false;
 
-    if (!ms_score_boom_anim_tex.loadFromFile("./src/blum_red_sign.png"))
+    if (!atlas.add_strip("./src/blum_red_sign.png", 1, ms_score_boom_frames))
         success = false;
 
-    // Загрузка шрифта
-    if (!ms_score_font.loadFromFile("./src/Consolas.ttf"))
+    // Растеризация символов шрифта (жирным) в атлас
+    if (!ms_score_font.load(atlas, "./src/Consolas.ttf", mc_font_size, true))
         success = false;
 
     return success;
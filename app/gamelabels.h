@@ -2,10 +2,11 @@
 #define GAMELABELS_H
 
 #include <SFML/Graphics.hpp>
-#include <iomanip>
-#include <string>
+#include <vector>
 
+#include "glyphfont.h"
 #include "label.h"
+#include "textureatlas.h"
 
 // =======================================================
 // ===================== Timer label =====================
@@ -41,25 +42,27 @@ public:
     void set_time(int32_t cur_time);
 
     /**
-     * @brief Отрисовывает метку таймера на окне.
-     * @param window Окно, в котором будет производиться отрисовка.
+     * @brief Добавляет метку таймера в пакет отрисовки.
+     * @param batch Пакет отрисовки.
      * @param cur_time Текущее время в игре.
      */
-    void draw(sf::RenderWindow& window, int32_t cur_time);
+    void draw(SpriteBatch& batch, int32_t cur_time);
 
     /**
      * @brief Загружает ресурсы, необходимые для отображения таймера.
+     * @param atlas Атлас текстур, в который добавляются картинки метки.
      * @return true, если ресурсы успешно загружены, false в противном случае.
      */
-    static bool load_resources(void);
+    static bool load_resources(TextureAtlas& atlas);
 
 private:
     /**
      * @brief Форматирует время в секундах в строку вида "MM:SS".
      * @param seconds Время в секундах.
-     * @return Форматированная строка.
+     * @param buffer Буфер для строки.
+     * @param size Размер буфера.
      */
-    std::string format_seconds(int seconds) const;
+    void format_seconds(int seconds, char* buffer, std::size_t size) const;
 
     /**
      * @brief Вычисляет позицию текста по оси X.
@@ -98,13 +101,14 @@ private:
     bool m_is_ice = false;             ///< Флаг состояния "заморозка".
     sf::FloatRect m_game_board;        ///< Прямоугольник игрового поля.
     int32_t m_start_ice_time = -1;     ///< Время начала эффекта "заморозка".
+    int32_t m_cur_time = -1;           ///< Отображаемое сейчас время (в секундах).
     const float mc_picture_size_w = 136.f; ///< Ширина заднего фона для таймера
     const float mc_picture_size_h = 46.f; ///< Высота заднего фона для таймера.
     const int32_t mc_ice_time = 2000;  ///< Время эффекта "заморозка" (2 сек).
-    const std::size_t mc_font_size = 35; ///< Стандартный размер шрифта.
-    static sf::Texture ms_timer_idle_anim_tex; ///< Текстура для нормального состояния.
-    static sf::Texture ms_timer_ice_anim_tex; ///< Текстура для состояния "заморозка".
-    static sf::Font ms_timer_font; ///< Шрифт для отображения таймера.
+    static constexpr unsigned mc_font_size = 35; ///< Стандартный размер шрифта.
+    static std::vector<AtlasFrame> ms_timer_idle_frames; ///< Кадры нормального состояния в атласе.
+    static std::vector<AtlasFrame> ms_timer_ice_frames; ///< Кадры состояния "заморозка" в атласе.
+    static GlyphFont ms_timer_font; ///< Растровый шрифт для отображения таймера.
 };
 
 // =======================================================
@@ -141,17 +145,18 @@ public:
     void boom(void);
 
     /**
-     * @brief Отрисовывает метку на окне.
-     * @param window Окно, в котором будет производиться отрисовка.
+     * @brief Добавляет метку в пакет отрисовки.
+     * @param batch Пакет отрисовки.
      * @param cur_time Текущее время в игре.
      */
-    void draw(sf::RenderWindow& window, int32_t cur_time);
+    void draw(SpriteBatch& batch, int32_t cur_time);
 
     /**
      * @brief Загружает ресурсы, необходимые для отображения метки.
+     * @param atlas Атлас текстур, в который добавляются картинки метки.
      * @return true, если ресурсы успешно загружены, false в противном случае.
      */
-    static bool load_resources(void);
+    static bool load_resources(TextureAtlas& atlas);
 
 private:
     /**
@@ -202,13 +207,13 @@ private:
     int32_t m_start_increase_time = -1; ///< Время начала увеличения.
     int32_t m_start_boom_time = -1;     ///< Время начала эффекта "взрыв".
 
-    const std::size_t mc_font_size = 35; ///< Стандартный размер шрифта.
+    static constexpr unsigned mc_font_size = 35; ///< Стандартный размер шрифта.
     const int32_t mc_increase_time = 500; ///< Время увеличения (0.5 сек).
     const float mc_increase_cof_per_sec = 0.5f; ///< Интервал увеличения текста (каждую секунду увеличивается на 5%).
     const int32_t mc_boom_time = 500; ///< Время эффекта "взрыв" (0.5 сек).
-    static sf::Texture ms_score_idle_anim_tex; ///< Текстура для нормального состояния.
-    static sf::Texture ms_score_boom_anim_tex; ///< Текстура для состояния "взрыв".
-    static sf::Font ms_score_font; ///< Шрифт для отображения очков.
+    static std::vector<AtlasFrame> ms_score_idle_frames; ///< Кадры нормального состояния в атласе.
+    static std::vector<AtlasFrame> ms_score_boom_frames; ///< Кадры состояния "взрыв" в атласе.
+    static GlyphFont ms_score_font; ///< Растровый шрифт для отображения очков.
 };
 
 #endif // GAMELABELS_H
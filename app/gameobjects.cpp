@@ -2,24 +2,6 @@
 
 namespace
 {
-    /**
-     * @brief Генерирует случайное число типа float в заданном диапазоне [min, max].
-     *
-     * Функция использует генератор случайных чисел для создания числа типа float
-     * в заданном диапазоне. Используется равномерное распределение.
-     *
-     * @param min Минимальное значение диапазона.
-     * @param max Максимальное значение диапазона.
-     * @return Случайное число типа float в диапазоне [min, max].
-     */
-    float random_on_duration(float min, float max)
-    {
-        std::random_device rd;   // Используется для получения случайного стартового значения
-        std::mt19937 gen(rd());  // Инициализация генератора случайных чисел Mersenne Twister
-        std::uniform_real_distribution<float> dist(min, max);  // Определение равномерного распределения в диапазоне [min, max]
-        return dist(gen);  // Генерация случайного числа
-    }
-
     /**
      * @brief Настройка объекта Object с заданными параметрами игрового поля.
      *
@@ -30,21 +12,14 @@ namespace
      */
     void setting_object(Object& obj, const sf::FloatRect& game_board)
     {
-        obj.set_direction(sf::Vector2f(0.f, 1.f));  ///< Установка направления движения вниз
-
-        float size = random_on_duration(26, 45);
-        obj.set_size(sf::Vector2f(size, size));  ///< Установка размера объекта
-
-        // Генерация случайной позиции по оси X в пределах игрового поля
-        float from = game_board.left;
-        float to = game_board.left + game_board.width - size;
-        float pos_x = random_on_duration(from, to);
-         // Позиция по оси Y выше верхней границы игрового поля
-        float pos_y = game_board.top - size;
-        obj.set_position(sf::Vector2f(pos_x, pos_y));  ///< Установка позиции объекта
-
-        float speed = random_on_duration(150.f, 200.f);
-        obj.set_speed(speed);  ///< Установка скорости объекта
+        // Отдельные объекты создаются только в главном потоке, поэтому одного генератора достаточно
+        static MatchRandom random(std::random_device{}());
+        SpawnParams params = make_spawn_params(game_board, random);
+
+        obj.set_direction(params.direction);  ///< Установка направления движения
+        obj.set_size(params.size);  ///< Установка размера объекта
+        obj.set_position(params.position);  ///< Установка позиции объекта
+        obj.set_speed(params.speed);  ///< Установка скорости объекта
     }
 }
 
@@ -52,10 +27,10 @@ namespace
 // ===================== Blum =====================
 // ================================================
 
-// Статические переменные класса Blum для хранения текстур
-sf::Texture Blum::ms_glow_tex;
-sf::Texture Blum::ms_activ_tex;
-sf::Texture Blum::ms_idle_tex;
+// Статические переменные класса Blum для хранения кадров
+std::vector<AtlasFrame> Blum::ms_glow_frames;
+std::vector<AtlasFrame> Blum::ms_activ_frames;
+std::vector<AtlasFrame> Blum::ms_idle_frames;
 
 /**
  * @brief Конструктор перемещения класса Blum.
@@ -85,31 +60,42 @@ Blum& Blum::operator=(Blum&& other) noexcept
  * @param game_board Прямоугольник, представляющий игровое поле.
  */
 Blum::Blum(const sf::FloatRect& game_board)
-    : Object(ms_glow_tex, 12, 200,  // Инициализация базового класса Object с glow текстурой, количеством спрайтов и задержкой
-             ms_activ_tex, 3, 150,
-             ms_idle_tex, 15, 150)
+    : Object(make_skin()) // Инициализация базового класса Object анимациями Blum
 {
     setting_object(*this, game_board);
 }
 
+/**
+ * @brief Создает внешний вид объекта Blum.
+ *
+ * @return Набор анимаций glow, active и idle.
+ */
+ObjectSkin Blum::make_skin(void)
+{
+    return ObjectSkin(ms_glow_frames, 200,  // Инициализация внешнего вида с кадрами glow и задержкой
+                      ms_activ_frames, mc_activ_change_time,
+                      ms_idle_frames, 150);
+}
+
 /**
  * @brief Загрузка ресурсов для класса Blum.
  *
- * Загружает текстуры из файлов и проверяет успешность загрузки.
+ * Загружает полосы кадров из файлов в атлас и проверяет успешность загрузки.
  *
+ * @param atlas Атлас текстур.
  * @return true, если все текстуры успешно загружены, иначе false.
  */
-bool Blum::load_resources(void)
+bool Blum::load_resources(TextureAtlas& atlas)
 {
     bool success = true;
 
-    if (!ms_glow_tex.loadFromFile("src/blum_glow.png"))  // Загрузка glow текстуры
+    if (!atlas.add_strip("src/blum_glow.png", 12, ms_glow_frames))  // Загрузка glow текстуры
         success = false;
 
-    if (!ms_activ_tex.loadFromFile("src/blum_activ.png"))  // Загрузка active текстуры
+    if (!atlas.add_strip("src/blum_activ.png", mc_activ_frame_count, ms_activ_frames))  // Загрузка active текстуры
         success = false;
 
-    if (!ms_idle_tex.loadFromFile("src/blum.png"))  // Загрузка idle текстуры
+    if (!atlas.add_strip("src/blum.png", 15, ms_idle_frames))  // Загрузка idle текстуры
         success = false;
 
     return success;
@@ -119,10 +105,10 @@ bool Blum::load_resources(void)
 // ===================== Ice ==========================
 // ====================================================
 
-// Статические переменные для хранения текстур класса Ice
-sf::Texture Ice::ms_glow_tex;
-sf::Texture Ice::ms_activ_tex;
-sf::Texture Ice::ms_idle_tex;
+// Статические переменные для хранения кадров класса Ice
+std::vector<AtlasFrame> Ice::ms_glow_frames;
+std::vector<AtlasFrame> Ice::ms_activ_frames;
+std::vector<AtlasFrame> Ice::ms_idle_frames;
 
 /**
  * @brief Конструктор перемещения для класса Ice.
@@ -152,31 +138,42 @@ Ice& Ice::operator=(Ice&& other) noexcept
  * @param game_board Прямоугольник, представляющий игровое поле.
  */
 Ice::Ice(const sf::FloatRect& game_board)
-    : Object(ms_glow_tex, 2, 242,  // Инициализация базового класса Object с текстурой glow, количеством спрайтов и задержкой
-             ms_activ_tex, 4, 200,
-             ms_idle_tex, 9, 200)
+    : Object(make_skin()) // Инициализация базового класса Object анимациями Ice
 {
     setting_object(*this, game_board); // Настройка объекта в пределах игрового поля
 }
 
+/**
+ * @brief Создает внешний вид объекта Ice.
+ *
+ * @return Набор анимаций glow, active и idle.
+ */
+ObjectSkin Ice::make_skin(void)
+{
+    return ObjectSkin(ms_glow_frames, 242,  // Инициализация внешнего вида с кадрами glow и задержкой
+                      ms_activ_frames, mc_activ_change_time,
+                      ms_idle_frames, 200);
+}
+
 /**
  * @brief Загрузка ресурсов для класса Ice.
  *
- * Загружает текстуры из файлов и проверяет успешность загрузки.
+ * Загружает полосы кадров из файлов в атлас и проверяет успешность загрузки.
  *
+ * @param atlas Атлас текстур.
  * @return true, если все текстуры успешно загружены, иначе false.
  */
-bool Ice::load_resources()
+bool Ice::load_resources(TextureAtlas& atlas)
 {
     bool success = true;
 
-    if (!ms_glow_tex.loadFromFile("src/ice_glow.png"))
+    if (!atlas.add_strip("src/ice_glow.png", 2, ms_glow_frames))
         success = false;
 
-    if (!ms_activ_tex.loadFromFile("src/ice_activ.png"))
+    if (!atlas.add_strip("src/ice_activ.png", mc_activ_frame_count, ms_activ_frames))
         success = false;
 
-    if (!ms_idle_tex.loadFromFile("src/ice.png"))
+    if (!atlas.add_strip("src/ice.png", 9, ms_idle_frames))
         success = false;
 
     return success;
@@ -185,10 +182,10 @@ bool Ice::load_resources()
 // ===================== Bomb =========================
 // ====================================================
 
-// Статические переменные для хранения текстур класса Bomb
-sf::Texture Bomb::ms_glow_tex;
-sf::Texture Bomb::ms_activ_tex;
-sf::Texture Bomb::ms_idle_tex;
+// Статические переменные для хранения кадров класса Bomb
+std::vector<AtlasFrame> Bomb::ms_glow_frames;
+std::vector<AtlasFrame> Bomb::ms_activ_frames;
+std::vector<AtlasFrame> Bomb::ms_idle_frames;
 
 /**
  * @brief Конструктор перемещения для класса Bomb.
@@ -218,31 +215,42 @@ Bomb& Bomb::operator=(Bomb&& other) noexcept
  * @param game_board Прямоугольник, представляющий игровое поле.
  */
 Bomb::Bomb(const sf::FloatRect& game_board)
-    : Object(ms_glow_tex, 1, 1000,  // Инициализация базового класса Object с текстурой glow, количеством спрайтов и задержкой
-             ms_activ_tex, 3, 200,
-             ms_idle_tex, 7, 200)
+    : Object(make_skin()) // Инициализация базового класса Object анимациями Bomb
 {
     setting_object(*this, game_board); // Настройка объекта в пределах игрового поля
 }
 
+/**
+ * @brief Создает внешний вид объекта Bomb.
+ *
+ * @return Набор анимаций glow, active и idle.
+ */
+ObjectSkin Bomb::make_skin(void)
+{
+    return ObjectSkin(ms_glow_frames, 1000,  // Инициализация внешнего вида с кадрами glow и задержкой
+                      ms_activ_frames, mc_activ_change_time,
+                      ms_idle_frames, 200);
+}
+
 /**
  * @brief Загрузка ресурсов для класса Bomb.
  *
- * Загружает текстуры из файлов и проверяет успешность загрузки.
+ * Загружает полосы кадров из файлов в атлас и проверяет успешность загрузки.
  *
+ * @param atlas Атлас текстур.
  * @return true, если все текстуры успешно загружены, иначе false.
  */
-bool Bomb::load_resources()
+bool Bomb::load_resources(TextureAtlas& atlas)
 {
     bool success = true;
 
-    if (!ms_glow_tex.loadFromFile("src/null.png"))
+    if (!atlas.add_strip("src/null.png", 1, ms_glow_frames))
         success = false;
 
-    if (!ms_activ_tex.loadFromFile("src/bomb_activ.png"))
+    if (!atlas.add_strip("src/bomb_activ.png", mc_activ_frame_count, ms_activ_frames))
         success = false;
 
-    if (!ms_idle_tex.loadFromFile("src/bomb.png"))
+    if (!atlas.add_strip("src/bomb.png", 7, ms_idle_frames))
         success = false;
 
     return success;
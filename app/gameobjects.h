@@ -4,6 +4,8 @@
 #include <SFML/Graphics.hpp>
 #include <random>
 #include "object.h"
+#include "spawnparams.h"
+#include "textureatlas.h"
 
 // ================================================
 // ===================== Blum =====================
@@ -20,6 +22,11 @@
 class Blum final: public Object
 {
 public:
+    // Нажатый объект живет, пока проигрывается анимация активации, поэтому их произведение должно
+    // совпадать с MatchSimulation::get_activation_time (это проверяет test_match_activation_time)
+    static constexpr std::size_t mc_activ_frame_count = 3; ///< Количество кадров анимации активации.
+    static constexpr int32_t mc_activ_change_time = 150; ///< Время смены кадров анимации активации в миллисекундах.
+
     /**
      * @brief Конструктор по умолчанию.
      */
@@ -49,19 +56,30 @@ public:
      */
     Blum& operator=(Blum&& other) noexcept;
 
+    /**
+     * @brief Создает внешний вид (набор анимаций) объекта Blum.
+     *
+     * Используется хранилищем сущностей, которому не нужен объект целиком.
+     *
+     * @return Внешний вид объекта Blum.
+     */
+    static ObjectSkin make_skin(void);
+
     /**
      * @brief Загрузка ресурсов для класса Blum.
      *
-     * Загружает текстуры из файлов и проверяет успешность загрузки.
+     * Загружает полосы кадров из файлов в атлас. Кадры станут доступны
+     * после сборки атласа (TextureAtlas::build).
      *
+     * @param atlas Атлас текстур.
      * @return true, если все текстуры успешно загружены, иначе false.
      */
-    static bool load_resources();
+    static bool load_resources(TextureAtlas& atlas);
 
 private:
-    static sf::Texture ms_glow_tex;   ///< Текстура для glow состояния
-    static sf::Texture ms_activ_tex;  ///< Текстура для active состояния
-    static sf::Texture ms_idle_tex;   ///< Текстура для idle состояния
+    static std::vector<AtlasFrame> ms_glow_frames;   ///< Кадры glow состояния в атласе
+    static std::vector<AtlasFrame> ms_activ_frames;  ///< Кадры active состояния в атласе
+    static std::vector<AtlasFrame> ms_idle_frames;   ///< Кадры idle состояния в атласе
 };
 
 // ===============================================
@@ -79,6 +97,9 @@ private:
 class Ice final: public Object
 {
 public:
+    static constexpr std::size_t mc_activ_frame_count = 4; ///< Количество кадров анимации активации.
+    static constexpr int32_t mc_activ_change_time = 200; ///< Время смены кадров анимации активации в миллисекундах.
+
     /**
      * @brief Конструктор по умолчанию.
      */
@@ -108,19 +129,30 @@ public:
      */
     Ice& operator=(Ice&& other) noexcept;
 
+    /**
+     * @brief Создает внешний вид (набор анимаций) объекта Ice.
+     *
+     * Используется хранилищем сущностей, которому не нужен объект целиком.
+     *
+     * @return Внешний вид объекта Ice.
+     */
+    static ObjectSkin make_skin(void);
+
     /**
      * @brief Загрузка ресурсов для класса Ice.
      *
-     * Загружает текстуры из файлов и проверяет успешность загрузки.
+     * Загружает полосы кадров из файлов в атлас. Кадры станут доступны
+     * после сборки атласа (TextureAtlas::build).
      *
+     * @param atlas Атлас текстур.
      * @return true, если все текстуры успешно загружены, иначе false.
      */
-    static bool load_resources();
+    static bool load_resources(TextureAtlas& atlas);
 
 private:
-    static sf::Texture ms_glow_tex;   ///< Текстура для glow состояния
-    static sf::Texture ms_activ_tex;  ///< Текстура для active состояния
-    static sf::Texture ms_idle_tex;   ///< Текстура для idle состояния
+    static std::vector<AtlasFrame> ms_glow_frames;   ///< Кадры glow состояния в атласе
+    static std::vector<AtlasFrame> ms_activ_frames;  ///< Кадры active состояния в атласе
+    static std::vector<AtlasFrame> ms_idle_frames;   ///< Кадры idle состояния в атласе
 };
 
 // ================================================
@@ -138,6 +170,9 @@ private:
 class Bomb final: public Object
 {
 public:
+    static constexpr std::size_t mc_activ_frame_count = 3; ///< Количество кадров анимации активации.
+    static constexpr int32_t mc_activ_change_time = 200; ///< Время смены кадров анимации активации в миллисекундах.
+
     /**
      * @brief Конструктор по умолчанию.
      */
@@ -167,19 +202,30 @@ public:
      */
     Bomb& operator=(Bomb&& other) noexcept;
 
+    /**
+     * @brief Создает внешний вид (набор анимаций) объекта Bomb.
+     *
+     * Используется хранилищем сущностей, которому не нужен объект целиком.
+     *
+     * @return Внешний вид объекта Bomb.
+     */
+    static ObjectSkin make_skin(void);
+
     /**
      * @brief Загрузка ресурсов для класса Bomb.
      *
-     * Загружает текстуры из файлов и проверяет успешность загрузки.
+     * Загружает полосы кадров из файлов в атлас. Кадры станут доступны
+     * после сборки атласа (TextureAtlas::build).
      *
+     * @param atlas Атлас текстур.
      * @return true, если все текстуры успешно загружены, иначе false.
      */
-    static bool load_resources();
+    static bool load_resources(TextureAtlas& atlas);
 
 private:
-    static sf::Texture ms_glow_tex;   ///< Текстура для glow состояния
-    static sf::Texture ms_activ_tex;  ///< Текстура для active состояния
-    static sf::Texture ms_idle_tex;   ///< Текстура для idle состояния
+    static std::vector<AtlasFrame> ms_glow_frames;   ///< Кадры glow состояния в атласе
+    static std::vector<AtlasFrame> ms_activ_frames;  ///< Кадры active состояния в атласе
+    static std::vector<AtlasFrame> ms_idle_frames;   ///< Кадры idle состояния в атласе
 };
 
 #endif // GAMEOBJECTS_H
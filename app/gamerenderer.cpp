@@ -1,323 +1,545 @@
 #include "gamerenderer.h"
 
+#include <cmath>
+#include <random>
+
 // Инициализация статических членов класса
-sf::Texture GameRenderer::ms_background_tex;
-sf::Texture GameRenderer::ms_frozen_background_tex;
-sf::Texture GameRenderer::ms_boom_background_tex;
-std::mt19937 GameRenderer::ms_gen;
-std::uniform_int_distribution<std::size_t> GameRenderer::ms_dist;
+TextureAtlas GameRenderer::ms_atlas;
+std::vector<AtlasFrame> GameRenderer::ms_background_frames;
+std::vector<AtlasFrame> GameRenderer::ms_frozen_background_frames;
+std::vector<AtlasFrame> GameRenderer::ms_boom_background_frames;
 
 // Конструктор класса GameRenderer
 GameRenderer::GameRenderer(const sf::FloatRect& game_board)
+    : GameRenderer(game_board, game_board)
+{
+}
+
+// Конструктор для поля больше экрана
+GameRenderer::GameRenderer(const sf::FloatRect& game_board, const sf::FloatRect& screen)
     : m_game_board(game_board),
-      m_background_anim(ms_background_tex, 1, 1000),
-      m_frozen_background_anim(ms_frozen_background_tex, 6, 200),
-      m_boom_background_anim(ms_boom_background_tex, 4, 200),
-      m_score(game_board),
-      m_timer(game_board)
+      m_screen(screen),
+      m_match(game_board, std::random_device{}()),
+      m_background_anim(ms_background_frames, 1000),
+      m_frozen_background_anim(ms_frozen_background_frames, 200),
+      m_boom_background_anim(ms_boom_background_frames, 200),
+      m_score(screen),
+      m_timer(screen)
 {
+    // Получаем события матча, чтобы создавать внешний вид объектов и эффекты
+    m_match.set_observer(this);
+
     // Изменяем размеры анимаций в соответсвии с размером предоставленного поля
     sf::Vector2f game_board_size(game_board.width, game_board.height);
     m_background_anim.resize(game_board_size);
     m_frozen_background_anim.resize(game_board_size);
     m_boom_background_anim.resize(game_board_size);
 
+    // Часы фона ведет планировщик; взрыв и заморозка ждут событий матча
+    m_background_anim.schedule(m_scheduler, true, 0);
+    m_frozen_background_anim.schedule(m_scheduler, false, -1);
+    m_boom_background_anim.schedule(m_scheduler, false, -1);
+
+    // Резервируем память, чтобы не перераспределять ее во время игры
+    m_scheduler.reserve(256 * 3 * 3);
+    for (ObjectPool<ObjectSkin>& pool : m_skin_pools)
+        pool.reserve(256);
+    m_number_pool.reserve(64);
+    m_numbers.reserve(64);
+    m_object_vertices.reserve(ObjectSkin::mc_max_vertices);
+
+    // Заполняем кэш вершин для всех размеров, с которыми появляются объекты:
+    // иначе редкий размер впервые встретится посреди игры и выделит память
+    ObjectSkin skins[] = {Blum::make_skin(), Ice::make_skin(), Bomb::make_skin()};
+    for (ObjectSkin& skin : skins)
+    {
+        for (float size = c_spawn_min_size; size <= c_spawn_max_size; size += 1.f)
+        {
+            skin.resize(sf::Vector2f(size, size));
+            skin.prepare_geometry();
+        }
+    }
+}
 
+// Деструктор: дописываем повтор до конца матча
+GameRenderer::~GameRenderer()
+{
+    stop_recording();
 }
 
 // Метод обновления игры
 void GameRenderer::update(int32_t cur_time)
 {
-    if (m_start_time == -1)
-        m_start_time = cur_time;
+    m_cur_time = cur_time; // Анимации появления и нажатия начинаются со времени шага, как и в симуляции
+    m_match.update(cur_time); // Правила игры: движение, появление и удаление объектов, таймер
+    if (m_recorder && m_match.get_tick() % mc_checksum_interval == 0)
+        m_recorder->record_checksum(m_match.get_tick(), m_match.get_checksum());
+    update_numbers(cur_time); // Движение всплывающих чисел
+    update_labels(); // Обновление отображаемой информации
+}
 
-    spawn_objects(); // Создание новых объектов
-    make_movement(cur_time); // Выполнение движения объектов
-    update_labels(cur_time); // Обновление отображаемой информации
-    delete_died_objects(); // Удаление уничтоженных объектов
+// Выбор способа обновления
+void GameRenderer::set_update_mode(UpdateMode mode)
+{
+    m_match.set_update_mode(mode);
 }
 
-// Обработка клика мыши
-void GameRenderer::click(const sf::Vector2f &mouse_pos)
+// Настройка вероятностей появления объектов
+void GameRenderer::set_spawn_chances(std::size_t blum, std::size_t ice, std::size_t bomb)
 {
-    bool was_hit = false;
-    // Проверяем каждый объект на попадание
-    for (Blum& blum : m_blums)
-    {
-        if (blum.try_press(mouse_pos))
-        {
-            m_cash += 1; // Увеличиваем счетчик
-            statistics["blum"] += 1; // Обновляем статистику
-            was_hit = true;
-            m_numbers.emplace_back(blum.get_rect(), 1); // Добавляем цифру
-        }
-    }
-    for (Ice& ice : m_ices)
+    m_match.set_spawn_chances(blum, ice, bomb);
+}
+
+// Настройка правила обработки клика
+void GameRenderer::set_click_policy(ClickPolicy policy)
+{
+    m_match.set_click_policy(policy);
+}
+
+// Выбор способа отрисовки
+bool GameRenderer::set_render_mode(RenderMode mode)
+{
+    if (mode == RenderMode::Stream && !VertexStream::is_available())
     {
-        if (ice.try_press(mouse_pos))
-        {
-            m_is_freezing = true; // Включаем заморозку
-            m_freeze_start_time = -1; // Сбрасываем время заморозки
-
-            m_timer.ice(); // Обновляем таймер
-            m_frozen_background_anim.start(); // Запускаем анимацию
-            statistics["ice"] += 1; // Обновляем статистику
-            was_hit = true;
-            m_numbers.emplace_back(ice.get_rect(), 0); // Добавляем цифру
-        }
+        m_render_mode = RenderMode::Batch;
+        return false;
     }
-    for (Bomb& bomb : m_bombs)
+    m_render_mode = mode;
+    return true;
+}
+
+// Количество объектов на поле
+std::size_t GameRenderer::get_objects_count(void) const
+{
+    return m_match.get_entities().size();
+}
+
+// Обработка клика мыши
+void GameRenderer::click(const sf::Vector2f &mouse_pos)
+{
+    // Эффекты нажатия запускаются из on_hit
+    if (!m_recorder)
     {
-        if (bomb.try_press(mouse_pos))
-        {
-            m_is_boom = true; // Включаем взрыв бомбы
-            m_boom_background_anim.start(); // Запускаем анимацию взрыва
-            m_score.boom(); // Обновляем счет
-            statistics["bomb"] += 1; // Обновляем статистику
-            was_hit = true;
-            m_numbers.emplace_back(bomb.get_rect(), -100); // Добавляем цифру с отрицательным значением
-
-            // Уменьшаем счет
-            m_cash = std::max(0, m_cash - 100);
-        }
+        m_match.click(mouse_pos);
+        return;
     }
-    if (!was_hit)
-        statistics["miss"] += 1; // Если промах, увеличиваем счетчик промахов
+
+    // В повтор попадают целые координаты, поэтому и матч получает их же
+    sf::Vector2i pos(static_cast<int>(std::lround(mouse_pos.x)), static_cast<int>(std::lround(mouse_pos.y)));
+    m_recorder->record_click(m_match.get_tick(), pos);
+    m_match.click(sf::Vector2f(pos));
+}
+
+// Начало записи матча
+bool GameRenderer::start_recording(const std::string& path, int32_t tick_time)
+{
+    if (m_recorder || m_match.get_tick() != 0)
+        return false;
+
+    ReplayHeader header;
+    header.seed = m_match.get_seed();
+    header.tick_time = tick_time;
+    header.checksum_interval = mc_checksum_interval;
+    header.game_board = m_game_board;
+
+    auto recorder = std::make_unique<ReplayWriter>();
+    if (!recorder->open(path, header))
+        return false;
+    m_recorder = std::move(recorder);
+    return true;
+}
+
+// Завершение записи матча
+void GameRenderer::stop_recording(void)
+{
+    if (!m_recorder)
+        return;
+    m_recorder->finish(m_match.get_tick());
+    m_recorder.reset();
+}
+
+// Количество выделений памяти за последний кадр
+std::size_t GameRenderer::get_frame_allocations(void) const
+{
+    return m_frame_allocations;
 }
 
 // Проверка окончания игры
 bool GameRenderer::is_game_over(void) const
 {
-    return m_time_passed > mc_match_time; // Возвращает true, если время игры истекло
+    return m_match.is_game_over(); // Возвращает true, если время игры истекло
 }
 
-// Отрисовка на экране
-void GameRenderer::draw(sf::RenderWindow &window, int32_t cur_time)
+// Отрисовка на экране или в текстуру
+void GameRenderer::draw(sf::RenderTarget& target, int32_t cur_time, float alpha)
 {
     sf::Vector2f game_board_pos(m_game_board.left, m_game_board.top);
-    sf::Sprite background;
 
-    ///< Отображаем задний фон в зависимости от текущего игрового состояния
-    if (m_is_boom && !m_boom_background_anim.is_end(cur_time))
+    // Видимая часть поля (вид без поворота)
+    const sf::View& view = target.getView();
+    sf::FloatRect view_rect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+
+    // Все анимации продвигаются одним проходом, дальше отрисовка только читает номера кадров
+    m_scheduler.advance(cur_time);
+    for (AnimationScheduler::Handle handle : m_scheduler.get_finished())
     {
-        background = m_boom_background_anim.get_sprite(cur_time);
+        // Закончившуюся активацию объекта не показывает сам объект, а фоны выключаем здесь
+        if (handle == m_boom_background_anim.get_handle())
+            m_is_boom = false;
+        else if (handle == m_frozen_background_anim.get_handle())
+            m_is_frozen = false;
     }
+
+    // Кадр собирается в пакет и рисуется одним вызовом на текстуру каждого слоя
+    m_batch.clear();
+
+    ///< Отображаем задний фон в зависимости от текущего игрового состояния
+    // Пока кадры взрыва не загружены, остается обычный фон
+    if (m_is_boom && ms_boom_background_frames.front().texture != nullptr)
+        m_boom_background_anim.draw(m_batch, SpriteBatch::Layer::Background, game_board_pos, cur_time);
     else
-    {
-        m_is_boom = false;
-        background = m_background_anim.get_sprite(cur_time);
-    }
+        m_background_anim.draw(m_batch, SpriteBatch::Layer::Background, game_board_pos, cur_time);
 
-    background.setPosition(game_board_pos);
-    window.draw(background);
+    // отображаем объекты, попавшие в видимую область.
+    // Постоянный буфер рисуется одним вызовом с одной текстурой: если видимые объекты лежат на разных
+    // страницах атласа, часть из них оказалась бы поверх всего буфера, поэтому такой кадр целиком
+    // рисуется пакетом, в том же порядке, что и в режиме Batch
+    bool is_stream = m_render_mode == RenderMode::Stream;
+    if (!is_stream || !add_objects(view_rect, cur_time, alpha, true))
+        add_objects(view_rect, cur_time, alpha, false);
 
-    // отображаем объекты
-    std::for_each(m_blums.begin(), m_blums.end(), [&window, cur_time](Blum& blum){
-        blum.draw(window, cur_time);
-    });
-    std::for_each(m_ices.begin(), m_ices.end(), [&window, cur_time](Ice& ice){
-        ice.draw(window, cur_time);
-    });
-    std::for_each(m_bombs.begin(), m_bombs.end(), [&window, cur_time](Bomb& bomb){
-        bomb.draw(window, cur_time);
-    });
-    std::for_each(m_numbers.begin(), m_numbers.end(), [&window](Number& num){
-        num.draw(window);
-    });
+    for (std::uint32_t id : m_numbers)
+    {
+        const Number& number = m_number_pool.get(id);
+        if (number.is_visible(view_rect))
+            number.draw(m_batch);
+    }
 
     // Если нужно отображаем анимацию льда
-    if (m_is_freezing && !m_frozen_background_anim.is_end(cur_time)) // Если анимация еще не закончилась
+    if (m_match.is_freezing() && m_is_frozen) // Если анимация еще не закончилась
     {
-        sf::Sprite frozen_screen = m_frozen_background_anim.get_sprite(cur_time);
-        frozen_screen.setPosition(game_board_pos);
-        window.draw(frozen_screen);
+        m_frozen_background_anim.draw(m_batch, SpriteBatch::Layer::Overlay, game_board_pos, cur_time);
     }
 
     // отображаем метки
-    m_score.draw(window, cur_time);
-    m_timer.draw(window, cur_time);
+    m_score.draw(m_batch, cur_time);
+    m_timer.draw(m_batch, cur_time);
+
+    // Поле рисуем камерой, а метки - в координатах экрана.
+    // Постоянный буфер объектов рисуется между фоном и объектами пакета
+    m_is_stream_drawn = m_stream_texture != nullptr;
+    if (m_is_stream_drawn)
+    {
+        m_batch.draw(target, SpriteBatch::Layer::Background, SpriteBatch::Layer::Background);
+        m_stream.draw(target, *m_stream_texture);
+        m_batch.draw(target, SpriteBatch::Layer::Objects, SpriteBatch::Layer::Overlay);
+    }
+    else
+    {
+        m_batch.draw(target, SpriteBatch::Layer::Background, SpriteBatch::Layer::Overlay);
+    }
+    sf::View camera = view;
+    target.setView(sf::View(m_screen));
+    m_batch.draw(target, SpriteBatch::Layer::Labels, SpriteBatch::Layer::Labels);
+    target.setView(camera);
+
+    // Выделения памяти за кадр: все шаги симуляции с прошлой отрисовки и эта отрисовка
+    std::size_t alloc_count = AllocCounter::get_count();
+    m_frame_allocations = alloc_count - m_alloc_mark;
+    m_alloc_mark = alloc_count;
+}
+
+// Количество вызовов отрисовки за последний кадр
+std::size_t GameRenderer::get_draw_calls(void) const
+{
+    return m_batch.get_draw_calls() + (m_is_stream_drawn ? 1 : 0);
+}
+
+// Количество смен состояния за последний кадр
+std::size_t GameRenderer::get_state_changes(void) const
+{
+    // Постоянный буфер рисуется отдельно от пакета и считается сменой состояния
+    return m_batch.get_state_changes() + (m_is_stream_drawn ? 1 : 0);
+}
+
+// Количество видимых объектов за последний кадр
+std::size_t GameRenderer::get_visible_objects(void) const
+{
+    return m_visible_objects;
+}
+
+// Закрашенная площадь за последний кадр
+std::size_t GameRenderer::get_pixel_count(void) const
+{
+    return m_batch.get_pixel_count() + (m_is_stream_drawn ? m_stream.get_pixel_count() : 0);
+}
+
+// Объем переданных видеокарте вершин за последний кадр
+std::size_t GameRenderer::get_uploaded_bytes(void) const
+{
+    std::size_t bytes = m_batch.get_quad_count() * 6 * sizeof(sf::Vertex);
+    if (m_is_stream_drawn)
+        bytes += m_stream.get_uploaded_bytes();
+    return bytes;
+}
+
+// Объекты матча
+const EntityStore& GameRenderer::get_entities(void) const
+{
+    return m_match.get_entities();
 }
 
 // Загрузка ресурсов
-bool GameRenderer::load_resources(void)
+bool GameRenderer::load_resources(const std::string& pack_path)
 {
-    bool success = true;
-    if (!ms_background_tex.loadFromFile("./src/background.png"))
+    bool success = start_loading(pack_path, nullptr);
+    if (!finish_loading(TextureAtlas::Priority::Deferred))
+        success = false;
+    return success;
+}
+
+// Начало загрузки ресурсов
+bool GameRenderer::start_loading(const std::string& pack_path, ThreadPool* pool)
+{
+    // Без пака (или с поврежденным паком) все читается из файлов
+    if (!pack_path.empty())
+        ms_atlas.load_pack(pack_path);
+
+    ms_atlas.set_thread_pool(pool);
+    return add_resources();
+}
+
+// Готовность ресурсов
+bool GameRenderer::is_loaded(TextureAtlas::Priority priority)
+{
+    return ms_atlas.is_ready(priority);
+}
+
+// Количество незагруженных ресурсов
+std::size_t GameRenderer::get_pending_resources(TextureAtlas::Priority priority)
+{
+    return ms_atlas.get_pending_count(priority);
+}
+
+// Окончание загрузки ресурсов
+bool GameRenderer::finish_loading(TextureAtlas::Priority priority)
+{
+    // Раскладываем по страницам атласа кадры, которых не было в паке
+    bool success = ms_atlas.build(priority);
+
+    // Когда загружено все, пул потоков атласу больше не нужен
+    if (priority == TextureAtlas::Priority::Deferred)
+        ms_atlas.set_thread_pool(nullptr);
+    return success;
+}
+
+// Длительности загрузки ресурсов
+const std::vector<TextureAtlas::LoadTiming>& GameRenderer::get_load_timings(void)
+{
+    return ms_atlas.get_timings();
+}
+
+// Сборка пака ресурсов
+bool GameRenderer::bake_resources(const std::string& pack_path)
+{
+    bool success = add_resources();
+    if (!ms_atlas.save_pack(pack_path))
         success = false;
+    return success;
+}
 
-    if (!ms_frozen_background_tex.loadFromFile("./src/frozen_anim.png"))
+// Количество прочитанных картинок
+std::size_t GameRenderer::get_decoded_images(void)
+{
+    return ms_atlas.get_decoded_count();
+}
+
+// Добавление всех ресурсов в атлас
+bool GameRenderer::add_resources(void)
+{
+    bool success = true;
+    if (!ms_atlas.add_strip("./src/background.png", 1, ms_background_frames))
         success = false;
 
-    if (!ms_boom_background_tex.loadFromFile("./src/boom_background_anim.png"))
+    // Заморозка и взрыв показываются только по событиям матча, первый кадр их не ждет
+    if (!ms_atlas.add_strip("./src/frozen_anim.png", 6, ms_frozen_background_frames,
+                            TextureAtlas::Priority::Deferred))
         success = false;
 
-    if (!ScoreLabel::load_resources())
+    if (!ms_atlas.add_strip("./src/boom_background_anim.png", 4, ms_boom_background_frames,
+                            TextureAtlas::Priority::Deferred))
         success = false;
 
-    if (!TimerLabel::load_resources())
+    if (!ScoreLabel::load_resources(ms_atlas))
         success = false;
 
-    if (!Blum::load_resources())
+    if (!TimerLabel::load_resources(ms_atlas))
         success = false;
 
-    if (!Ice::load_resources())
+    if (!Blum::load_resources(ms_atlas))
         success = false;
 
-    if (!Bomb::load_resources())
+    if (!Ice::load_resources(ms_atlas))
         success = false;
 
-    if (!Number::load_resources())
+    if (!Bomb::load_resources(ms_atlas))
         success = false;
 
-    std::random_device rd;   // устройство генерации случайных чисел
-    ms_gen.seed(rd());          // инициализация генератора случайных чисел с устройства
-    ms_dist = std::uniform_int_distribution<std::size_t>(0, 1000); // равномерное распределение от 0 до 1000
+    if (!Number::load_resources(ms_atlas))
+        success = false;
 
     return success;
 }
 
-// Удаление умерших объектов
-void GameRenderer::delete_died_objects(void)
+// Появление нового объекта
+std::uint32_t GameRenderer::on_spawn(EntityKind kind, const SpawnParams& params)
 {
-    // Определяем вышедшие за границы game_board объекты и удаляем их
-    remove_departed_elements(m_blums);
-    remove_departed_elements(m_ices);
-    remove_departed_elements(m_bombs);
+    // Берем внешний вид из пула, новый создается только если пул пуст
+    ObjectPool<ObjectSkin>& pool = m_skin_pools[static_cast<std::size_t>(kind)];
+    std::uint32_t skin_id = pool.acquire([kind]() {
+        switch (kind)
+        {
+        case EntityKind::Ice:
+            return Ice::make_skin();
+        case EntityKind::Bomb:
+            return Bomb::make_skin();
+        case EntityKind::Blum:
+        default:
+            return Blum::make_skin();
+        }
+    });
 
-    // Определяем умершие элементы и удаляем их
-    remove_died_elements(m_blums);
-    remove_died_elements(m_ices);
-    remove_died_elements(m_bombs);
-    remove_died_elements(m_numbers);
+    // Сбрасываем состояние переиспользуемого внешнего вида, его часы ведет планировщик
+    ObjectSkin& skin = pool.get(skin_id);
+    skin.schedule(m_scheduler, m_cur_time);
+    skin.resize(params.size);
+
+    return skin_id;
 }
 
-// Создание новых объектов
-void GameRenderer::spawn_objects(void)
+// Возврат внешнего вида в пул
+void GameRenderer::on_remove(EntityKind kind, std::uint32_t tag)
 {
-    if (!m_is_freezing) // Если мы не в режиме заморозки
-    {
-        // Создаем элементы с заданной для их типа вероятностью
-        if (should_spawn_object(m_blum_probability))
-            m_blums.emplace_back(m_game_board);
+    ObjectPool<ObjectSkin>& pool = m_skin_pools[static_cast<std::size_t>(kind)];
+    pool.get(tag).unschedule(); // В планировщике остаются только живые анимации
+    pool.release(tag);
+}
 
-        if (should_spawn_object(m_bomb_probability))
-            m_bombs.emplace_back(m_game_board);
+// Эффекты нажатия на объект
+void GameRenderer::on_hit(EntityKind kind, std::uint32_t tag, const sf::FloatRect& rect)
+{
+    // Запускаем активную анимацию
+    m_skin_pools[static_cast<std::size_t>(kind)].get(tag).start_activation(m_cur_time);
 
-        if (should_spawn_object(m_ice_probability))
-            m_ices.emplace_back(m_game_board);
+    switch (kind)
+    {
+    case EntityKind::Blum:
+        add_number(rect, 1); // Добавляем цифру
+        break;
+
+    case EntityKind::Ice:
+        m_timer.ice(); // Обновляем таймер
+        m_frozen_background_anim.start(m_cur_time); // Запускаем анимацию
+        m_is_frozen = true;
+        add_number(rect, 0); // Добавляем цифру
+        break;
+
+    case EntityKind::Bomb:
+        m_is_boom = true; // Включаем взрыв бомбы
+        m_boom_background_anim.start(m_cur_time); // Запускаем анимацию взрыва
+        m_score.boom(); // Обновляем счет
+        add_number(rect, -100); // Добавляем цифру с отрицательным значением
+        break;
     }
 }
 
-// Движение объектов
-void GameRenderer::make_movement(int32_t cur_time)
+// Движение всплывающих чисел
+void GameRenderer::update_numbers(int32_t cur_time)
 {
-    // Перемещаем объекты в соответствии с deltatime концепцией
-    move_elements(m_blums, cur_time);
-    move_elements(m_ices, cur_time);
-    move_elements(m_bombs, cur_time);
-    move_elements(m_numbers, cur_time);
+    // Двигаем числа и сразу уплотняем, мертвые числа возвращаем в пул
+    std::size_t write = 0;
+    for (std::uint32_t id : m_numbers)
+    {
+        Number& number = m_number_pool.get(id);
+        number.move(cur_time);
+        if (number.get_status())
+            m_numbers[write++] = id;
+        else
+            m_number_pool.release(id);
+    }
+    m_numbers.resize(write);
 }
 
-// Обновление меток и таймера
-void GameRenderer::update_labels(int32_t cur_time)
+// Добавление видимых объектов в кадр
+bool GameRenderer::add_objects(const sf::FloatRect& view_rect, int32_t cur_time, float alpha, bool is_stream)
 {
-    // Работа с таймером
-    if (!m_is_freezing) // Если мы не в заморозке
+    const EntityStore& entities = m_match.get_entities();
+    m_stream_texture = nullptr; // Текстура буфера определяется заново в каждом кадре
+    if (is_stream)
+        m_stream.begin();
+    m_visible_objects = 0;
+    for (std::size_t i = 0; i < entities.size(); ++i)
     {
-        // Рассчитываем пройденной вермя как промежуток между текущим моментом
-        // и началом, без времени в заморозке
-        m_time_passed = cur_time - m_start_time - m_time_in_freezing_mode;
-        int32_t seconds_passed = m_time_passed / 1000;  // Переводим в секунды
-        int32_t seconds_left = mc_match_time / 1000 - seconds_passed; // Вычисляем сколько осталось
-        m_timer.set_time(seconds_left); // Устанавливаем время на таймер
-    }
-    else
-    {
-        // Увеличиваем общее время в режиме заморозки
-        m_time_in_freezing_mode += cur_time - m_last_freeze_time;
-
-        if (m_freeze_start_time == -1) // Если мы впервые заморозились
+        sf::FloatRect rect = entities.get_interpolated_rect(i, alpha); // Позиция между двумя шагами симуляции
+        // Свечение рисуется на половину высоты выше объекта
+        sf::FloatRect drawn_rect(rect.left, rect.top - rect.height / 2.f, rect.width, rect.height * 1.5f);
+        if (!drawn_rect.intersects(view_rect))
+            continue;
+        ++m_visible_objects;
+
+        ObjectSkin& skin = get_skin(i);
+        bool activated = entities.is_activated(i);
+        if (!is_stream)
         {
-            freeze_elements();  // Замораживаем все элементы
-            m_freeze_start_time = cur_time; // Запоминаем время когда мы начали
+            // Нажатый объект удаляет симуляция, когда истекает время его активации,
+            // а до этого отрисовка просто не показывает закончившуюся анимацию
+            skin.draw(m_batch, rect, activated, cur_time);
+            continue;
         }
-        if (m_freeze_start_time != -1 &&  // Если мы в заморозке слишком долго
-                cur_time - m_freeze_start_time >= mc_freeze_time)
-        {
-            m_is_freezing = false; // Выходим из заморозки
 
-            unfreeze_elements();    // Размораживаем все элементы
-            m_freeze_start_time = -1; // Очищаем стартовое время
+        // Объект в постоянном буфере занимает слот своей сущности, который не меняется при уплотнении хранилища
+        m_object_vertices.clear();
+        const sf::Texture* texture = skin.build(m_object_vertices, rect, activated, cur_time);
+        if (texture == nullptr && !skin.is_drawn(activated, cur_time))
+            continue;
+        if (texture == nullptr || (m_stream_texture != nullptr && texture != m_stream_texture))
+        {
+            // Кадр не завершается: записанные слоты остаются измененными и загрузятся со следующим кадром буфера
+            m_stream_texture = nullptr;
+            return false;
         }
+        m_stream_texture = texture;
+        m_stream.write(entities.get_handle(i).slot, m_object_vertices.data(), m_object_vertices.size());
     }
-    m_last_freeze_time = cur_time;
 
-    // Работа со счетом
-    m_score.set_score(m_cash);
-}
-
-// Заморозка объектов
-void GameRenderer::freeze_elements(void)
-{
-    sf::Vector2f direct(0.f, 0.f);
-    change_direction_elements(m_blums, direct);
-    change_direction_elements(m_ices, direct);
-    change_direction_elements(m_bombs, direct);
-}
-
-// Разморозка объектов
-void GameRenderer::unfreeze_elements(void)
-{
-    sf::Vector2f direct(0.f, 1.f);
-    change_direction_elements(m_blums, direct);
-    change_direction_elements(m_ices, direct);
-    change_direction_elements(m_bombs, direct);
+    // Без объектов буфер не рисуется, поэтому и изменения не собираются (их загрузит следующий кадр с объектами)
+    if (m_stream_texture != nullptr)
+        m_stream.finish();
+    return true;
 }
 
-// Удаление объектов, вышедших за границы игрового поля
-template <typename T>
-void GameRenderer::remove_departed_elements(std::list<T>& list)
+// Получение внешнего вида объекта
+ObjectSkin& GameRenderer::get_skin(std::size_t index)
 {
-    // Создаем прямоугольник на котором, могут находится объекты
-    sf::FloatRect sandbox(m_game_board.left, m_game_board.top - 100.f,
-                          m_game_board.width, m_game_board.height + 100.f);
-    // Если объекты непересекают данный прямоугольник, то они должны быть удалены
-    list.remove_if([sandbox](const T& obj) {
-        return !sandbox.intersects(obj.get_rect());
-    });
+    const EntityStore& entities = m_match.get_entities();
+    std::size_t pool = static_cast<std::size_t>(entities.get_kind(index));
+    return m_skin_pools[pool].get(entities.get_tag(index));
 }
 
-// Удаление "мертвых" объектов
-template <typename T>
-void GameRenderer::remove_died_elements(std::list<T>& list)
+// Добавление всплывающего числа
+void GameRenderer::add_number(const sf::FloatRect& rect, int n)
 {
-    list.remove_if([](const T& obj) {
-        return !obj.get_status();
-    });
+    std::uint32_t id = m_number_pool.acquire([]() { return Number(); });
+    m_number_pool.get(id).reset(rect, n);
+    m_numbers.push_back(id);
 }
 
-// Движение элементов
-template <typename T>
-void GameRenderer::move_elements(std::list<T>& list, int32_t cur_time) const
-{
-    std::for_each(list.begin(), list.end(), [cur_time](T& obj){
-       obj.move(cur_time);
-    });
-}
-
-// Изменение направления движения элементов
-template <typename T>
-void GameRenderer::change_direction_elements(std::list<T>& list, const sf::Vector2f& direct) const
-{
-    std::for_each(list.begin(), list.end(), [direct](T& obj){
-       obj.set_direction(direct);
-    });
-}
-
-// Проверка нужно ли создать новый объект
-bool GameRenderer::should_spawn_object(std::size_t chance) const
+// Обновление меток и таймера
+void GameRenderer::update_labels(void)
 {
-    std::size_t cur_num = ms_dist(ms_gen); // генерируем случайное число
+    // Во время заморозки оставшееся время не меняется
+    m_timer.set_time(m_match.get_seconds_left());
 
-    return cur_num < chance;
+    // Работа со счетом
+    m_score.set_score(m_match.get_cash());
 }
@@ -2,23 +2,48 @@
 #define GAMERENDERER_H
 
 #include <SFML/Graphics.hpp>
-#include <list>
-#include <map>
-#include <random> // для использования случайных чисел
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "alloccounter.h"
 #include "animation.h"
+#include "animationscheduler.h"
 #include "gameobjects.h"
 #include "gamelabels.h"
+#include "matchsimulation.h"
 #include "number.h"
+#include "objectpool.h"
+#include "replay.h"
+#include "spritebatch.h"
+#include "textureatlas.h"
+#include "vertexstream.h"
 
 /**
  * @brief Класс, отвечающий за отрисовку игры.
  *
- * Этот класс управляет отрисовкой и игровой логикой игры.
+ * Этот класс является представлением матча: правила игры выполняет
+ * MatchSimulation, а GameRenderer хранит внешний вид объектов, фон, числа
+ * и метки и отрисовывает их.
  */
-class GameRenderer
+class GameRenderer: private MatchObserver
 {
 public:
+    using UpdateMode = MatchSimulation::UpdateMode;   ///< Способ обновления игровых объектов за кадр.
+    using ClickPolicy = MatchSimulation::ClickPolicy; ///< Правило обработки клика по перекрывающимся объектам.
+
+    /**
+     * @brief Способ отрисовки игровых объектов.
+     */
+    enum class RenderMode
+    {
+        Batch,  ///< Вершины объектов собираются в пакет и передаются видеокарте заново каждый кадр.
+        Stream  ///< Вершины объектов хранятся в постоянном буфере, загружаются только изменения.
+    };
+
+    static constexpr const char* mc_pack_path = "./src/assets.pack"; ///< Пак ресурсов по умолчанию (относительно каталога app).
+
     /**
      * @brief Конструктор по умолчанию.
      */
@@ -31,9 +56,30 @@ public:
     explicit GameRenderer(const sf::FloatRect& game_board);
 
     /**
-     * @brief Деструктор по умолчанию.
+     * @brief Конструктор для поля, которое больше окна.
+     *
+     * Поле рисуется с видом цели отрисовки (камерой), а метки счета и
+     * таймера остаются на месте в прямоугольнике экрана.
+     *
+     * @param game_board Прямоугольник, задающий границы игрового поля.
+     * @param screen Прямоугольник экрана, в котором располагаются метки.
+     */
+    explicit GameRenderer(const sf::FloatRect& game_board, const sf::FloatRect& screen);
+
+    /**
+     * @brief Деструктор, завершающий запись матча, если она идет.
      */
-    ~GameRenderer() = default;
+    ~GameRenderer() override;
+
+    /**
+     * @brief Копирование запрещено: симуляция хранит указатель на представление.
+     */
+    GameRenderer(const GameRenderer&) = delete;
+
+    /**
+     * @brief Присваивание запрещено: симуляция хранит указатель на представление.
+     */
+    GameRenderer& operator=(const GameRenderer&) = delete;
 
     /**
      * @brief Обновляет состояние игры на основе текущего времени.
@@ -41,12 +87,67 @@ public:
      */
     void update(int32_t cur_time);
 
+    /**
+     * @brief Устанавливает способ обновления объектов (для сравнения производительности).
+     * @param mode Способ обновления.
+     */
+    void set_update_mode(UpdateMode mode);
+
+    /**
+     * @brief Устанавливает вероятности появления объектов в каждом кадре.
+     * @param blum Вероятность появления Blum (от 0 до 1000).
+     * @param ice Вероятность появления Ice (от 0 до 1000).
+     * @param bomb Вероятность появления Bomb (от 0 до 1000).
+     */
+    void set_spawn_chances(std::size_t blum, std::size_t ice, std::size_t bomb);
+
+    /**
+     * @brief Устанавливает правило обработки клика по перекрывающимся объектам.
+     * @param policy Правило обработки клика.
+     */
+    void set_click_policy(ClickPolicy policy);
+
+    /**
+     * @brief Устанавливает способ отрисовки объектов (для сравнения производительности).
+     *
+     * Если видеокарта не поддерживает буферы вершин, остается пакетная отрисовка.
+     *
+     * @param mode Способ отрисовки.
+     * @return false, если способ не поддерживается, иначе true.
+     */
+    bool set_render_mode(RenderMode mode);
+
+    /**
+     * @brief Количество объектов Blum, Ice и Bomb на поле.
+     * @return Количество объектов.
+     */
+    std::size_t get_objects_count(void) const;
+
     /**
      * @brief Обрабатывает событие клика мыши.
      * @param mouse_pos Позиция клика мыши.
      */
     void click(const sf::Vector2f& mouse_pos);
 
+    /**
+     * @brief Начинает запись матча в файл повтора.
+     *
+     * Записываются начальное значение генератора, длительность шага, клики
+     * и контрольные суммы состояния после каждого шага. Запись нужно начать
+     * до первого обновления, а update должен вызываться с шагом tick_time,
+     * начиная с нуля, иначе повтор не совпадет с матчем.
+     *
+     * @param path Путь к файлу повтора.
+     * @param tick_time Длительность шага симуляции в миллисекундах.
+     * @return True, если запись начата, false, если матч уже идет или файл не открывается.
+     */
+    bool start_recording(const std::string& path, int32_t tick_time);
+
+    /**
+     * @brief Завершает запись матча (вызывается и при уничтожении объекта).
+     */
+    void stop_recording(void);
+
     /**
      * @brief Проверяет, завершена ли игра.
      * @return True, если игра завершена, false в противном случае.
@@ -54,125 +155,257 @@ public:
     bool is_game_over(void) const;
 
     /**
-     * @brief Отрисовывает игровые объекты на окне.
-     * @param window Окно SFML для отрисовки.
+     * @brief Отрисовывает игровые объекты на цели отрисовки (окне или текстуре).
+     *
+     * Объекты рисуются между позициями двух последних обновлений, что дает
+     * плавное движение при отрисовке чаще, чем шаги симуляции. Кадр
+     * собирается в пакет по слоям (фон, объекты, числа, заморозка, метки)
+     * и рисуется одним вызовом на каждую текстуру слоя.
+     *
+     * Поле рисуется с текущим видом цели (камерой, без поворота): объекты и
+     * числа вне видимой области не рисуются, и их анимации не продвигаются.
+     * Метки рисуются в координатах экрана.
+     *
+     * @param target Цель отрисовки (окно или sf::RenderTexture).
      * @param cur_time Текущее время в миллисекундах.
+     * @param alpha Доля шага симуляции от предыдущего обновления к последнему (1 - последнее состояние).
+     */
+    void draw(sf::RenderTarget& target, int32_t cur_time, float alpha = 1.f);
+
+    /**
+     * @brief Количество вызовов отрисовки в последнем кадре.
+     *
+     * Прямоугольники с одной текстурой в пределах слоя рисуются одним
+     * вызовом, поэтому значение не зависит от количества объектов на поле.
+     *
+     * @return Количество вызовов отрисовки.
      */
-    void draw(sf::RenderWindow& window, int32_t cur_time);
+    std::size_t get_draw_calls(void) const;
+
+    /**
+     * @brief Количество смен текстуры или режима смешивания в последнем кадре.
+     * @return Количество смен состояния.
+     */
+    std::size_t get_state_changes(void) const;
+
+    /**
+     * @brief Площадь всех прямоугольников последнего кадра в пикселях.
+     *
+     * Перекрывающиеся прямоугольники считаются каждый, поэтому значение
+     * показывает нагрузку на заполнение, а не размер окна.
+     *
+     * @return Количество закрашенных пикселей.
+     */
+    std::size_t get_pixel_count(void) const;
+
+    /**
+     * @brief Объем вершин, переданных видеокарте в последнем кадре, в байтах.
+     *
+     * Вершины пакета передаются целиком при каждой отрисовке, а из
+     * постоянного буфера объектов - только изменившиеся диапазоны.
+     *
+     * @return Количество переданных байт.
+     */
+    std::size_t get_uploaded_bytes(void) const;
+
+    /**
+     * @brief Количество объектов, попавших в видимую область в последнем кадре.
+     * @return Количество нарисованных объектов.
+     */
+    std::size_t get_visible_objects(void) const;
+
+    /**
+     * @brief Объекты матча (для сценариев замеров и отладки).
+     * @return Хранилище объектов.
+     */
+    const EntityStore& get_entities(void) const;
 
     /**
      * @brief Загружает игровые ресурсы.
+     *
+     * Все картинки игры раскладываются по страницам одного атласа текстур,
+     * поэтому объекты разных типов, фон и метки рисуются с одной текстуры.
+     * Если задан пак (см. bake_resources), страницы атласа и символы шрифтов
+     * берутся из него, а из файлов читается только то, чего в паке нет.
+     *
+     * @param pack_path Путь к паку (пустой или несуществующий пак - все читается из файлов).
      * @return True, если ресурсы были успешно загружены, false в противном случае.
      */
-    static bool load_resources(void);
+    static bool load_resources(const std::string& pack_path = std::string());
 
-private:
     /**
-     * @brief Удаляет объекты, которые погибли.
+     * @brief Начинает загрузку игровых ресурсов, не дожидаясь декодирования картинок.
+     *
+     * Картинки декодируются в пуле потоков, а шрифты растеризуются сразу
+     * (в потоке OpenGL). Пока картинки декодируются, окно может показывать
+     * экран загрузки, опрашивая is_loaded. Загрузка заканчивается вызовами
+     * finish_loading: сначала для ресурсов первого кадра, потом для
+     * остальных (эффекты заморозки и взрыва).
+     *
+     * @param pack_path Путь к паку (пустой или несуществующий пак - все читается из файлов).
+     * @param pool Пул потоков (должен существовать до последнего finish_loading; nullptr - декодировать сразу).
+     * @return True, если шрифты загружены и картинки найдены или отданы в пул, false в противном случае.
      */
-    void delete_died_objects(void);
+    static bool start_loading(const std::string& pack_path, ThreadPool* pool);
 
     /**
-     * @brief Создает новые игровые объекты.
+     * @brief Проверяет, декодированы ли картинки, не дожидаясь их.
+     * @param priority TextureAtlas::Priority::FirstFrame - только нужные для первого кадра, Deferred - все.
+     * @return True, если finish_loading с этим приоритетом не будет ждать пул потоков, false в противном случае.
      */
-    void spawn_objects(void);
+    static bool is_loaded(TextureAtlas::Priority priority);
 
     /**
-     * @brief Выполняет перемещение элементов в зависимости от текущего времени.
-     * @param cur_time Текущее время в миллисекундах.
+     * @brief Количество картинок, которые еще декодируются в пуле потоков (для экрана загрузки).
+     * @param priority TextureAtlas::Priority::FirstFrame - только нужные для первого кадра, Deferred - все.
+     * @return Количество картинок.
      */
-    void make_movement(int32_t cur_time);
+    static std::size_t get_pending_resources(TextureAtlas::Priority priority);
 
     /**
-     * @brief Обновляет метки (лейблы) на основе текущего времени.
-     * @param cur_time Текущее время в миллисекундах.
+     * @brief Создает текстуры для декодированных картинок (в потоке OpenGL).
+     *
+     * Если картинки еще декодируются, дожидается их. После вызова с
+     * приоритетом FirstFrame можно создавать GameRenderer, остальные кадры
+     * появятся у него после вызова с приоритетом Deferred.
+     *
+     * @param priority TextureAtlas::Priority::FirstFrame - только нужные для первого кадра, Deferred - все.
+     * @return True, если картинки загружены и разложены по атласу, false в противном случае.
      */
-    void update_labels(int32_t cur_time);
+    static bool finish_loading(TextureAtlas::Priority priority);
 
     /**
-     * @brief Замораживает элементы игры.
+     * @brief Длительности загрузки отдельных ресурсов (для поиска причин медленного запуска).
+     * @return Длительности загрузки в порядке их окончания.
      */
-    void freeze_elements(void);
+    static const std::vector<TextureAtlas::LoadTiming>& get_load_timings(void);
 
     /**
-     * @brief Размораживает элементы игры.
+     * @brief Собирает пак ресурсов: раскладывает картинки и шрифты и сохраняет атлас в файл.
+     *
+     * Текстуры не создаются, после сборки ресурсы нужно загружать load_resources.
+     *
+     * @param pack_path Путь к паку.
+     * @return True, если все ресурсы прочитаны и пак записан, false в противном случае.
      */
-    void unfreeze_elements(void);
+    static bool bake_resources(const std::string& pack_path);
 
     /**
-     * @brief Удаляет элементы, которые покинули экран.
-     * @tparam T Тип элементов в списке.
-     * @param list Список элементов для обработки.
+     * @brief Количество картинок, прочитанных из файлов при загрузке ресурсов.
+     * @return Количество картинок (0, если все взято из пака).
      */
-    template <typename T>
-    void remove_departed_elements(std::list<T>& list);
+    static std::size_t get_decoded_images(void);
 
     /**
-     * @brief Удаляет элементы, которые погибли.
-     * @tparam T Тип элементов в списке.
-     * @param list Список элементов для обработки.
+     * @brief Количество выделений динамической памяти за последний кадр.
+     *
+     * Считается между окончаниями двух последовательных вызовов draw, то
+     * есть включает все шаги симуляции (update) между ними и отрисовку
+     * кадра. В установившемся режиме игры объекты берутся из пулов, и
+     * значение должно быть равно нулю.
+     *
+     * @return Количество выделений памяти за последний кадр.
      */
-    template <typename T>
-    void remove_died_elements(std::list<T>& list);
+    std::size_t get_frame_allocations(void) const;
 
+private:
     /**
-     * @brief Перемещает элементы в зависимости от текущего времени.
-     * @tparam T Тип элементов в списке.
-     * @param list Список элементов для перемещения.
+     * @brief Берет внешний вид нового объекта из пула.
+     * @param kind Тип объекта.
+     * @param params Параметры появления объекта.
+     * @return Номер внешнего вида в пуле своего типа.
+     */
+    std::uint32_t on_spawn(EntityKind kind, const SpawnParams& params) override;
+
+    /**
+     * @brief Возвращает внешний вид удаляемого объекта в пул.
+     * @param kind Тип объекта.
+     * @param tag Номер внешнего вида в пуле своего типа.
+     */
+    void on_remove(EntityKind kind, std::uint32_t tag) override;
+
+    /**
+     * @brief Запускает эффекты нажатия на объект.
+     * @param kind Тип объекта.
+     * @param tag Номер внешнего вида в пуле своего типа.
+     * @param rect Границы объекта в момент нажатия.
+     */
+    void on_hit(EntityKind kind, std::uint32_t tag, const sf::FloatRect& rect) override;
+
+    /**
+     * @brief Перемещает всплывающие числа и возвращает исчезнувшие в пул.
      * @param cur_time Текущее время в миллисекундах.
      */
-    template <typename T>
-    void move_elements(std::list<T>& list, int32_t cur_time) const;
+    void update_numbers(int32_t cur_time);
 
     /**
-     * @brief Изменяет направление движения элементов.
-     * @tparam T Тип элементов в списке.
-     * @param list Список элементов для обработки.
-     * @param direct Новый вектор направления.
+     * @brief Обновляет метки (лейблы) по состоянию матча.
      */
-    template <typename T>
-    void change_direction_elements(std::list<T>& list, const sf::Vector2f& direct) const;
+    void update_labels(void);
 
     /**
-     * @brief Определяет, должен ли объект появиться на основе вероятности.
-     * @param chance Вероятность появления объекта (от 0 до 1000).
-     * @return True, если объект должен появиться, false в противном случае.
+     * @brief Добавляет видимые объекты в кадр.
+     *
+     * В режиме постоянного буфера объекты записываются в его слоты, пока
+     * все они лежат на одной странице атласа. Если встречается объект с
+     * другой страницы (или с кадрами на разных страницах), добавление
+     * прерывается, и кадр нужно собрать заново пакетом.
+     *
+     * @param view_rect Видимая часть поля.
+     * @param cur_time Текущее время в миллисекундах.
+     * @param alpha Доля шага симуляции от предыдущего обновления к последнему.
+     * @param is_stream Записывать ли объекты в постоянный буфер (иначе - в пакет).
+     * @return false, если объекты нельзя нарисовать постоянным буфером, иначе true.
      */
-    bool should_spawn_object(std::size_t chance) const;
+    bool add_objects(const sf::FloatRect& view_rect, int32_t cur_time, float alpha, bool is_stream);
 
-    bool m_is_freezing = false; ///< Флаг, указывающий на нахождение игры в режиме заморозки.
-    bool m_is_boom = false; ///< Флаг, указывающий на наличие взрыва в игре.
+    /**
+     * @brief Возвращает внешний вид объекта из хранилища.
+     * @param index Плотный индекс объекта в хранилище.
+     * @return Ссылка на внешний вид объекта.
+     */
+    ObjectSkin& get_skin(std::size_t index);
 
-    int m_cash = 0; ///< Внутриигровая валюта игрока.
+    /**
+     * @brief Добавляет всплывающее число, переиспользуя объект из пула.
+     * @param rect Прямоугольник объекта, над которым появится число.
+     * @param n Отображаемое число.
+     */
+    void add_number(const sf::FloatRect& rect, int n);
 
-    const int32_t mc_freeze_time = 2000; ///< Продолжительность заморозки в миллисекундах (2 секунды).
-    const int32_t mc_match_time = 45000; ///< Общее время матча в миллисекундах (45 секунд).
+    /**
+     * @brief Добавляет в атлас все картинки и шрифты игры.
+     * @return True, если все ресурсы прочитаны (из пака или файлов), false в противном случае.
+     */
+    static bool add_resources(void);
 
-    int32_t m_start_time = -1; ///< Время начала игры.
-    int32_t m_time_passed = 0; ///< Прошедшее время с начала игры.
-    int32_t m_time_in_freezing_mode = 0; ///< Время, проведенное в режиме заморозки.
-    int32_t m_last_freeze_time = -1; ///< Последнее время, когда была заморозка.
-    int32_t m_freeze_start_time = -1; ///< Время начала заморозки.
+    bool m_is_boom = false; ///< Флаг, указывающий на наличие взрыва в игре.
+    bool m_is_frozen = false; ///< Флаг, указывающий, что идет анимация заморозки.
 
     sf::FloatRect m_game_board; ///< Прямоугольник, определяющий область игрового поля.
+    sf::FloatRect m_screen; ///< Прямоугольник экрана (для меток).
+    int32_t m_cur_time = 0; ///< Время последнего обновления (начало анимаций, запущенных событиями матча).
+    std::size_t m_visible_objects = 0; ///< Количество объектов в видимой области в последнем кадре.
+    MatchSimulation m_match; ///< Симуляция матча (правила игры).
+    std::unique_ptr<ReplayWriter> m_recorder; ///< Запись матча в файл повтора (nullptr - запись не идет).
 
-    std::list<Blum> m_blums; ///< Список объектов типа Blum в игре.
-    std::list<Ice> m_ices; ///< Список объектов типа Ice в игре.
-    std::list<Bomb> m_bombs; ///< Список объектов типа Bomb в игре.
+    AnimationScheduler m_scheduler; ///< Часы всех анимаций объектов и фона.
+    std::array<ObjectPool<ObjectSkin>, 3> m_skin_pools; ///< Пулы внешнего вида объектов по типам (EntityKind).
 
-    std::size_t m_bomb_probability = 2; ///< Вероятность появления бомб (от 0 до 1000).
-    std::size_t m_ice_probability = 2; ///< Вероятность появления льда (от 0 до 1000).
-    std::size_t m_blum_probability = 100; ///< Вероятность появления Blum (от 0 до 1000).
+    SpriteBatch m_batch; ///< Пакет отрисовки кадра.
 
-    std::list<Number> m_numbers; ///< Список объектов типа Number в игре.
+    RenderMode m_render_mode = RenderMode::Batch; ///< Способ отрисовки объектов.
+    VertexStream m_stream{ObjectSkin::mc_max_vertices}; ///< Постоянный буфер вершин объектов (слот - слот EntityStore).
+    const sf::Texture* m_stream_texture = nullptr; ///< Текстура объектов в постоянном буфере в текущем кадре (nullptr - буфер не рисуется).
+    bool m_is_stream_drawn = false; ///< Был ли нарисован постоянный буфер в последнем кадре.
+    std::vector<sf::Vertex> m_object_vertices; ///< Вершины одного объекта перед записью в буфер.
+
+    ObjectPool<Number> m_number_pool; ///< Пул объектов типа Number.
+    std::vector<std::uint32_t> m_numbers; ///< Номера живых объектов Number в пуле.
+
+    std::size_t m_alloc_mark = 0; ///< Показание счетчика выделений памяти в конце предыдущего кадра.
+    std::size_t m_frame_allocations = 0; ///< Количество выделений памяти за последний кадр.
 
-    std::map<std::string, std::size_t, std::less<>> statistics =///< Карта для хранения игровой статистики.
-    {
-        {"miss", 0},
-        {"bomb", 0},
-        {"ice",  0},
-        {"blum", 0}
-    };
     Animation m_background_anim; ///< Анимация для фона.
     Animation m_frozen_background_anim; ///< Анимация для замороженного фона.
     Animation m_boom_background_anim; ///< Анимация для взрывающегося фона.
@@ -180,12 +413,12 @@ private:
     ScoreLabel m_score; ///< Лейбл счета, отображающий счет игрока.
     TimerLabel m_timer; ///< Лейбл таймера, отображающий игровое время.
 
-    static sf::Texture ms_background_tex; ///< Статическая текстура для фона.
-    static sf::Texture ms_frozen_background_tex; ///< Статическая текстура для замороженного фона.
-    static sf::Texture ms_boom_background_tex; ///< Статическая текстура для взрывающегося фона.
+    static TextureAtlas ms_atlas; ///< Атлас со всеми кадрами игры.
+    static std::vector<AtlasFrame> ms_background_frames; ///< Кадры фона.
+    static std::vector<AtlasFrame> ms_frozen_background_frames; ///< Кадры замороженного фона.
+    static std::vector<AtlasFrame> ms_boom_background_frames; ///< Кадры взрывающегося фона.
 
-    static std::mt19937 ms_gen; ///< Статический генератор случайных чисел Mersenne Twister.
-    static std::uniform_int_distribution<std::size_t> ms_dist; ///< Статическое равномерное распределение.
+    static constexpr std::uint32_t mc_checksum_interval = 1; ///< Контрольная сумма в повтор пишется после каждого шага.
 };
 
 #endif // GAMERENDERER_H
@@ -0,0 +1,169 @@
+#include "glyphfont.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+// Растеризация символов шрифта
+bool GlyphFont::load(TextureAtlas& atlas, const std::string& path, unsigned character_size, bool bold,
+                     const std::string& chars)
+{
+    static_assert(std::is_trivially_copyable<Glyph>::value, "Glyph metrics are stored in the asset pack as is");
+
+    auto start = std::chrono::steady_clock::now();
+    m_character_size = character_size;
+    m_glyphs.fill(Glyph());
+
+    // Символы, растеризованные при сборке пака, берутся из него без загрузки шрифта
+    std::string name = "font:" + path + ":" + std::to_string(character_size) + (bold ? ":bold:" : ":") + chars;
+    std::size_t size = 0;
+    const char* packed = atlas.find_data(name, size);
+    if (packed != nullptr && size == sizeof(m_glyphs) && atlas.add_packed_strip(name, 1, m_page))
+    {
+        std::memcpy(m_glyphs.data(), packed, sizeof(m_glyphs));
+        atlas.add_timing(name, std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start).count(), false);
+        return true;
+    }
+
+    sf::Font font;
+    if (!font.loadFromFile(path))
+    {
+        atlas.add_strip(sf::Image(), 1, m_page); // Пустой кадр, текст просто не будет рисоваться
+        return false;
+    }
+
+    // Запрос символа растеризует его на странице шрифта
+    for (char c : chars)
+    {
+        unsigned char code = static_cast<unsigned char>(c);
+        if (code >= mc_glyph_count)
+            continue;
+
+        const sf::Glyph& glyph = font.getGlyph(code, character_size, bold);
+        m_glyphs[code] = Glyph{glyph.advance, glyph.bounds, glyph.textureRect};
+    }
+
+    // Страница шрифта целиком становится одним кадром атласа, размеры символов сохраняются для пака
+    atlas.add_strip(font.getTexture(character_size).copyToImage(), 1, m_page, name);
+    atlas.add_data(name, m_glyphs.data(), sizeof(m_glyphs));
+    // Растеризация идет в потоке OpenGL (страница шрифта - текстура), поэтому ее время тоже важно для запуска
+    atlas.add_timing(name, std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start).count(), false);
+    return true;
+}
+
+// Размер шрифта
+unsigned GlyphFont::get_character_size(void) const
+{
+    return m_character_size;
+}
+
+// Прямоугольник текста
+sf::FloatRect GlyphFont::get_bounds(const char* text, const sf::Vector2f& position, float scale) const
+{
+    float x = 0.f;
+    float baseline = static_cast<float>(m_character_size);
+    float min_x = 0.f;
+    float min_y = 0.f;
+    float max_x = 0.f;
+    float max_y = 0.f;
+    bool empty = true;
+
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        unsigned char code = static_cast<unsigned char>(*c);
+        if (code >= mc_glyph_count)
+            continue;
+
+        const Glyph& glyph = m_glyphs[code];
+        if (glyph.bounds.width > 0.f && glyph.bounds.height > 0.f)
+        {
+            float left = x + glyph.bounds.left;
+            float top = baseline + glyph.bounds.top;
+            float right = left + glyph.bounds.width;
+            float bottom = top + glyph.bounds.height;
+
+            min_x = empty ? left : std::min(min_x, left);
+            min_y = empty ? top : std::min(min_y, top);
+            max_x = empty ? right : std::max(max_x, right);
+            max_y = empty ? bottom : std::max(max_y, bottom);
+            empty = false;
+        }
+        x += glyph.advance;
+    }
+
+    return sf::FloatRect(position.x + min_x * scale, position.y + min_y * scale,
+                         (max_x - min_x) * scale, (max_y - min_y) * scale);
+}
+
+// Добавление текста в пакет отрисовки
+void GlyphFont::draw(SpriteBatch& batch, SpriteBatch::Layer layer, const char* text, const sf::Vector2f& position,
+                     float scale, const sf::Color& color) const
+{
+    const sf::Texture* texture = get_texture();
+    if (texture == nullptr)
+        return;
+
+    float x = 0.f;
+    sf::FloatRect rect;
+    sf::IntRect tex_rect;
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        unsigned char code = static_cast<unsigned char>(*c);
+        if (code >= mc_glyph_count)
+            continue;
+
+        const Glyph& glyph = m_glyphs[code];
+        if (get_quad(glyph, x, position, scale, rect, tex_rect))
+            batch.add(layer, *texture, rect, tex_rect, color);
+        x += glyph.advance;
+    }
+}
+
+// Запись текста в массив вершин
+void GlyphFont::build(std::vector<sf::Vertex>& vertices, const char* text, const sf::Vector2f& position,
+                      float scale, const sf::Color& color) const
+{
+    if (get_texture() == nullptr)
+        return;
+
+    float x = 0.f;
+    sf::FloatRect rect;
+    sf::IntRect tex_rect;
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        unsigned char code = static_cast<unsigned char>(*c);
+        if (code >= mc_glyph_count)
+            continue;
+
+        const Glyph& glyph = m_glyphs[code];
+        if (get_quad(glyph, x, position, scale, rect, tex_rect))
+            SpriteBatch::append_quad(vertices, rect, tex_rect, color);
+        x += glyph.advance;
+    }
+}
+
+// Текстура символов
+const sf::Texture* GlyphFont::get_texture(void) const
+{
+    return m_page.empty() ? nullptr : m_page[0].texture;
+}
+
+// Прямоугольники символа
+bool GlyphFont::get_quad(const Glyph& glyph, float x, const sf::Vector2f& position, float scale,
+                         sf::FloatRect& rect, sf::IntRect& tex_rect) const
+{
+    if (glyph.rect.width <= 0 || glyph.rect.height <= 0)
+        return false;
+
+    const AtlasFrame& page = m_page[0];
+    float baseline = static_cast<float>(m_character_size);
+    rect = sf::FloatRect(position.x + (x + glyph.bounds.left) * scale,
+                         position.y + (baseline + glyph.bounds.top) * scale,
+                         glyph.bounds.width * scale, glyph.bounds.height * scale);
+    tex_rect = sf::IntRect(page.rect.left + glyph.rect.left, page.rect.top + glyph.rect.top,
+                           glyph.rect.width, glyph.rect.height);
+    return true;
+}
@@ -0,0 +1,133 @@
+#ifndef GLYPHFONT_H
+#define GLYPHFONT_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "spritebatch.h"
+#include "textureatlas.h"
+
+/**
+ * @brief Растровый шрифт: заранее отрисованные символы в атласе текстур.
+ *
+ * При загрузке ресурсов нужные символы (по умолчанию цифры, "+", "-" и ":")
+ * один раз растеризуются из шрифта в картинку, которая добавляется в атлас.
+ * Текст затем выводится прямоугольниками в пакет отрисовки, со своим цветом
+ * и прозрачностью у каждой вершины, без создания sf::Text и пересчета его
+ * геометрии.
+ *
+ * Раскладка повторяет sf::Text: базовая линия на расстоянии размера шрифта
+ * от верхней точки позиции. Кернинг не учитывается (шрифт моноширинный).
+ */
+class GlyphFont
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit GlyphFont(void) = default;
+
+    GlyphFont(const GlyphFont&) = delete;
+    GlyphFont& operator=(const GlyphFont&) = delete;
+
+    /**
+     * @brief Растеризует символы шрифта и добавляет их картинку в атлас.
+     *
+     * Символы можно рисовать после вызова build у атласа. Если у атласа
+     * открыт пак с этим шрифтом, символы и их размеры берутся из пака, а
+     * файл шрифта не читается.
+     *
+     * @param atlas Атлас текстур.
+     * @param path Путь к файлу шрифта.
+     * @param character_size Размер шрифта в пикселях.
+     * @param bold Жирное начертание.
+     * @param chars Символы, которые будут доступны.
+     * @return true, если шрифт загружен, иначе false.
+     */
+    bool load(TextureAtlas& atlas, const std::string& path, unsigned character_size, bool bold,
+              const std::string& chars = "0123456789+-:");
+
+    /**
+     * @brief Размер шрифта, в котором растеризованы символы.
+     * @return Размер шрифта в пикселях.
+     */
+    unsigned get_character_size(void) const;
+
+    /**
+     * @brief Прямоугольник, который займет текст (аналог sf::Text::getGlobalBounds).
+     * @param text Текст (строка с нулем в конце).
+     * @param position Позиция текста.
+     * @param scale Масштаб текста.
+     * @return Прямоугольник текста.
+     */
+    sf::FloatRect get_bounds(const char* text, const sf::Vector2f& position, float scale = 1.f) const;
+
+    /**
+     * @brief Добавляет текст в пакет отрисовки.
+     *
+     * Символы, которых нет в шрифте, пропускаются.
+     *
+     * @param batch Пакет отрисовки.
+     * @param layer Слой отрисовки.
+     * @param text Текст (строка с нулем в конце).
+     * @param position Позиция текста.
+     * @param scale Масштаб текста.
+     * @param color Цвет текста (вместе с прозрачностью).
+     */
+    void draw(SpriteBatch& batch, SpriteBatch::Layer layer, const char* text, const sf::Vector2f& position,
+              float scale, const sf::Color& color) const;
+
+    /**
+     * @brief Записывает прямоугольники текста в массив вершин (для хранения между кадрами).
+     *
+     * Вершины рассчитаны на текстуру get_texture.
+     *
+     * @param vertices Куда добавить вершины.
+     * @param text Текст (строка с нулем в конце).
+     * @param position Позиция текста.
+     * @param scale Масштаб текста.
+     * @param color Цвет текста (вместе с прозрачностью).
+     */
+    void build(std::vector<sf::Vertex>& vertices, const char* text, const sf::Vector2f& position,
+               float scale, const sf::Color& color) const;
+
+    /**
+     * @brief Текстура атласа, на которой лежат символы.
+     * @return Текстура или nullptr, если шрифт не загружен.
+     */
+    const sf::Texture* get_texture(void) const;
+
+private:
+    /**
+     * @brief Растеризованный символ.
+     */
+    struct Glyph
+    {
+        float advance = 0.f;  ///< Сдвиг до следующего символа.
+        sf::FloatRect bounds; ///< Прямоугольник символа относительно базовой линии.
+        sf::IntRect rect;     ///< Прямоугольник символа в картинке шрифта.
+    };
+
+    /**
+     * @brief Вычисляет прямоугольники символа на экране и в атласе.
+     * @param glyph Символ.
+     * @param x Положение символа на строке.
+     * @param position Позиция текста.
+     * @param scale Масштаб текста.
+     * @param rect Прямоугольник на экране.
+     * @param tex_rect Прямоугольник в атласе.
+     * @return false, если у символа нет изображения (например, пробел).
+     */
+    bool get_quad(const Glyph& glyph, float x, const sf::Vector2f& position, float scale,
+                  sf::FloatRect& rect, sf::IntRect& tex_rect) const;
+
+    static constexpr std::size_t mc_glyph_count = 128; ///< Количество кодов символов (ASCII).
+
+    unsigned m_character_size = 0; ///< Размер шрифта в пикселях.
+    std::array<Glyph, mc_glyph_count> m_glyphs; ///< Символы по кодам.
+    std::vector<AtlasFrame> m_page; ///< Картинка с символами в атласе (один кадр).
+};
+
+#endif // GLYPHFONT_H
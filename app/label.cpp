@@ -1,62 +1,117 @@
 #include "label.h"
 
+#include <cstring>
 
-Label::Label(sf::Texture& tex, std::size_t n_sprites, int32_t change_time, const sf::Font& font)
-    :m_anim(tex, n_sprites, change_time)
+
+Label::Label(const std::vector<AtlasFrame>& frames, int32_t change_time, const GlyphFont& font)
+    :m_anim(frames, change_time),
+     m_font(&font)
 {
-    m_text.setFont(font);
+    // Вершины картинки и текста наибольшей длины: пересборка метки не выделяет память
+    m_picture_vertices.reserve(FrameGeometryCache::mc_frame_vertices);
+    m_string_vertices.reserve(mc_max_string_length * FrameGeometryCache::mc_frame_vertices);
 }
 
 // Настройка параметров текста (цвет и размер)
-void Label::set_string_settings(const sf::Color& color, std::size_t size, sf::Uint32 style)
+void Label::set_string_settings(const sf::Color& color, std::size_t size)
 {
-    m_text.setFillColor(color);
-    m_text.setCharacterSize(size);
-    m_text.setStyle(style);
+    // Символы растеризованы в размере шрифта, другой размер получается масштабом
+    unsigned character_size = m_font->get_character_size();
+    float size_scale = character_size > 0 ? static_cast<float>(size) / static_cast<float>(character_size) : 1.f;
+
+    if (color != m_string_color || size_scale != m_size_scale)
+    {
+        m_string_color = color;
+        m_size_scale = size_scale;
+        m_is_changed = true;
+    }
 }
 
 void Label::set_string_scale(float coefficient)
 {
-    m_text.setScale(1.f, 1.f); // сбрасываем старое масштабирование, чтобы оно не накладывалось с новым
-    m_text.setScale(coefficient, coefficient); // устанавливаем новое масштабирование
+    if (coefficient != m_string_scale)
+    {
+        m_string_scale = coefficient; // новое масштабирование заменяет старое
+        m_is_changed = true;
+    }
 }
 
 // Установка размера изображения
 void Label::set_picture_size(const sf::Vector2f& new_size)
 {
-    m_anim.resize(new_size);
+    if (new_size != m_anim.get_size())
+    {
+        m_anim.resize(new_size);
+        m_is_changed = true;
+    }
 }
 
 // Установка позиции изображения
 void Label::set_picture_position(const sf::Vector2f& new_pos)
 {
-    m_anim_position = new_pos;
+    if (new_pos != m_anim_position)
+    {
+        m_anim_position = new_pos;
+        m_is_changed = true;
+    }
 }
 
 // Установка позиции текста
 void Label::set_string_position(const sf::Vector2f& new_pos)
 {
-    m_text.setPosition(new_pos);
+    if (new_pos != m_string_position)
+    {
+        m_string_position = new_pos;
+        m_is_changed = true;
+    }
 }
 
 // Установка текста
-void Label::set_string(const std::string& new_string)
+void Label::set_string(const char* new_string)
+{
+    if (std::strncmp(new_string, m_string.data(), mc_max_string_length) == 0)
+        return;
+
+    std::strncpy(m_string.data(), new_string, mc_max_string_length);
+    m_string[mc_max_string_length] = '\0';
+    m_is_changed = true;
+}
+
+// Изменилась ли метка
+bool Label::is_changed(void) const
 {
-    m_text.setString(new_string);
+    return m_is_changed;
 }
 
 // Получение прямоугольника, описывающего текст
 sf::FloatRect Label::get_string_rect(void) const
 {
-    return m_text.getGlobalBounds();
+    return m_font->get_bounds(m_string.data(), m_string_position, m_size_scale * m_string_scale);
 }
 
-// Отрисовка изображения и текста в окне
-void Label::draw(sf::RenderWindow& window, int32_t cur_time)
+// Добавление изображения и текста в пакет отрисовки
+void Label::draw(SpriteBatch& batch, int32_t cur_time)
 {
-    sf::Sprite tmp = m_anim.get_sprite(cur_time);
-    tmp.setPosition(m_anim_position); // Позиционируем спрайт катринки (анимации)
+    const AtlasFrame& frame = m_anim.get_frame(cur_time);
+    if (m_is_changed || &frame != m_cached_frame)
+        rebuild(frame);
+
+    // Слой меток сохраняет порядок добавления, поэтому текст остается поверх картинки
+    if (frame.texture != nullptr)
+        batch.add(SpriteBatch::Layer::Labels, *frame.texture, m_picture_vertices);
+    if (m_font->get_texture() != nullptr)
+        batch.add(SpriteBatch::Layer::Labels, *m_font->get_texture(), m_string_vertices);
+}
+
+// Пересборка сохраненных вершин
+void Label::rebuild(const AtlasFrame& frame)
+{
+    m_picture_vertices.clear();
+    SpriteBatch::append_quad(m_picture_vertices, sf::FloatRect(m_anim_position, m_anim.get_size()), frame.rect);
+
+    m_string_vertices.clear();
+    m_font->build(m_string_vertices, m_string.data(), m_string_position, m_size_scale * m_string_scale, m_string_color);
 
-    window.draw(tmp);
-    window.draw(m_text);
+    m_cached_frame = &frame;
+    m_is_changed = false;
 }
@@ -2,12 +2,20 @@
 #define LABEL_H
 
 #include <SFML/Graphics.hpp>
-#include <string>
+#include <array>
+#include <vector>
 #include "animation.h"
+#include "glyphfont.h"
+#include "spritebatch.h"
 
 /**
  * @class Label
  * @brief Класс для управления текстовыми и графическими метками с возможностью анимации.
+ *
+ * Метка хранит готовые вершины картинки и текста и пересобирает их только
+ * после изменения текста, его параметров, размера или позиции картинки
+ * (или смены кадра анимации). В остальных кадрах отрисовка только копирует
+ * сохраненные вершины в пакет.
  */
 class Label
 {
@@ -19,12 +27,11 @@ public:
 
     /**
      * @brief Параметризованный конструктор для создания метки с текстурой, анимацией и шрифтом.
-     * @param tex Текстура для анимации.
-     * @param n_sprites Количество спрайтов в анимации.
+     * @param frames Кадры анимации в атласе текстур.
      * @param change_time Время смены спрайтов в анимации.
-     * @param font Шрифт для текста метки.
+     * @param font Растровый шрифт для текста метки (должен существовать, пока существует метка).
      */
-    explicit Label(sf::Texture& tex, std::size_t n_sprites, int32_t change_time, const sf::Font& font);
+    explicit Label(const std::vector<AtlasFrame>& frames, int32_t change_time, const GlyphFont& font);
 
     /**
      * @brief Деструктор.
@@ -44,11 +51,13 @@ public:
 
     /**
      * @brief Установка параметров текста.
+     *
+     * Начертание (например, жирное) задается при растеризации шрифта.
+     *
      * @param color Цвет текста.
      * @param size Размер текста.
-     * @param style Стиль текста (обычный, жирный и т.д.).
      */
-    void set_string_settings(const sf::Color& color = sf::Color::White, std::size_t size = 20, sf::Uint32 style = 0);
+    void set_string_settings(const sf::Color& color = sf::Color::White, std::size_t size = 20);
 
     /**
      * @brief Установка параметров текста.
@@ -76,9 +85,18 @@ public:
 
     /**
      * @brief Установка текста.
-     * @param new_string Новый текст.
+     *
+     * Текст длиннее mc_max_string_length обрезается.
+     *
+     * @param new_string Новый текст (строка с нулем в конце).
      */
-    void set_string(const std::string& new_string);
+    void set_string(const char* new_string);
+
+    /**
+     * @brief Изменилась ли метка с последней отрисовки.
+     * @return true, если при следующей отрисовке вершины будут пересобраны, иначе false.
+     */
+    bool is_changed(void) const;
 
     /**
      * @brief Получение прямоугольника, описывающего текст.
@@ -87,16 +105,33 @@ public:
     sf::FloatRect get_string_rect(void) const;
 
     /**
-     * @brief Отрисовка метки на окне.
-     * @param window Окно для отрисовки.
+     * @brief Добавление метки в слой меток пакета отрисовки.
+     * @param batch Пакет отрисовки.
      * @param cur_time Текущее время для управления анимацией.
      */
-    void draw(sf::RenderWindow& window, int32_t cur_time);
+    void draw(SpriteBatch& batch, int32_t cur_time);
+
+    static constexpr std::size_t mc_max_string_length = 15; ///< Наибольшая длина текста.
 
 private:
+    /**
+     * @brief Пересобирает сохраненные вершины картинки и текста.
+     * @param frame Текущий кадр картинки.
+     */
+    void rebuild(const AtlasFrame& frame);
+
     sf::Vector2f m_anim_position; ///< Позиция анимации.
     Animation m_anim; ///< Картинка (анимация) метки.
-    sf::Text m_text; ///< Текст метки.
+    const GlyphFont* m_font = nullptr; ///< Растровый шрифт текста.
+    std::array<char, mc_max_string_length + 1> m_string{}; ///< Текст метки (строка с нулем в конце).
+    sf::Vector2f m_string_position; ///< Позиция текста.
+    sf::Color m_string_color = sf::Color::White; ///< Цвет текста.
+    float m_size_scale = 1.f; ///< Масштаб шрифта до заданного размера текста.
+    float m_string_scale = 1.f; ///< Дополнительный масштаб текста.
+    bool m_is_changed = true; ///< Нужно ли пересобрать вершины.
+    const AtlasFrame* m_cached_frame = nullptr; ///< Кадр картинки, по которому собраны вершины.
+    std::vector<sf::Vertex> m_picture_vertices; ///< Сохраненные вершины картинки.
+    std::vector<sf::Vertex> m_string_vertices; ///< Сохраненные вершины текста.
 };
 
 #endif // LABEL_H
@@ -1,28 +1,194 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <random>
+#include <string>
 
 #include "gamerenderer.h"
-#include "gameobjects.h"
+#include "threadpool.h"
 
-int main()
+// Частота симуляции по умолчанию (шагов в секунду)
+constexpr int32_t c_default_tick_rate = 100;
+// Максимум шагов симуляции за один кадр, чтобы не отставать все сильнее при нагрузке
+constexpr int32_t c_max_ticks_per_frame = 8;
+// Размер окна (и поля по умолчанию)
+constexpr unsigned c_window_width = 402;
+constexpr unsigned c_window_height = 712;
+// Изменение масштаба камеры за одно деление колесика мыши
+constexpr float c_zoom_step = 1.1f;
+// Размер полосы загрузки
+constexpr float c_progress_width = 300.f;
+constexpr float c_progress_height = 12.f;
+
+// Экран загрузки: полоса с долей уже декодированных картинок
+void draw_loading(sf::RenderWindow& window, float progress)
 {
-    sf::RenderWindow window(sf::VideoMode(402, 712), "Blum");
-    window.setFramerateLimit(60);
+    sf::Vector2f size(c_progress_width, c_progress_height);
+    sf::Vector2f pos((c_window_width - size.x) / 2.f, (c_window_height - size.y) / 2.f);
+
+    sf::RectangleShape frame(size);
+    frame.setPosition(pos);
+    frame.setFillColor(sf::Color::Transparent);
+    frame.setOutlineColor(sf::Color::White);
+    frame.setOutlineThickness(1.f);
 
-    sf::FloatRect game_board(0,0,402,712);
+    sf::RectangleShape bar(sf::Vector2f(size.x * progress, size.y));
+    bar.setPosition(pos);
+    bar.setFillColor(sf::Color::White);
 
-    Blum blum(game_board);
+    window.clear();
+    window.draw(frame);
+    window.draw(bar);
+    window.display();
+}
 
-    if (!GameRenderer::load_resources())
+// Подсказка по аргументам командной строки
+void print_usage(const char* program)
+{
+    std::cerr << "usage: " << program << " [ticks_per_second] [--record <file>] [--board <width>x<height>]"
+              << " [--pack <file>] [--timings]" << std::endl;
+}
+
+// Частота симуляции из аргумента: только число целиком, от 1 до 1000
+bool parse_tick_rate(const char* text, int32_t& tick_rate)
+{
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < 1 || value > 1000)
+        return false;
+
+    tick_rate = static_cast<int32_t>(value);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    sf::Clock startup_clock; // Время запуска: от начала main до первого показанного кадра
+
+    // Частоту симуляции можно задать аргументом (шагов в секунду),
+    // "--record <файл>" записывает матч в файл повтора,
+    // "--board <ширина>x<высота>" задает поле больше окна,
+    // "--pack <файл>" - пак ресурсов (пустая строка - читать ресурсы из файлов),
+    // а "--timings" печатает длительность загрузки каждого ресурса
+    int32_t tick_rate = c_default_tick_rate;
+    std::string replay_path;
+    bool print_timings = false;
+    std::string pack_path = GameRenderer::mc_pack_path;
+    sf::FloatRect screen(0, 0, c_window_width, c_window_height);
+    sf::FloatRect game_board = screen;
+    // Неизвестный аргумент или флаг без значения - ошибка, а не частота симуляции
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--record" && has_value)
+            replay_path = argv[++i];
+        else if (arg == "--pack" && has_value)
+            pack_path = argv[++i];
+        else if (arg == "--timings")
+            print_timings = true;
+        else if (arg == "--board" && has_value)
+        {
+            unsigned width = 0;
+            unsigned height = 0;
+            char rest = 0;
+            if (std::sscanf(argv[++i], "%ux%u%c", &width, &height, &rest) != 2 || width == 0 || height == 0)
+            {
+                print_usage(argv[0]);
+                return 1;
+            }
+            game_board = sf::FloatRect(0, 0, width, height);
+        }
+        else if (!parse_tick_rate(argv[i], tick_rate))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    // Шаг симуляции - целое число миллисекунд, поэтому подходят только частоты, которые делят 1000 нацело
+    // (иначе, например, 60 дало бы шаг 16 мс, то есть 62.5 шага в секунду)
+    if (1000 % tick_rate != 0)
+    {
+        std::cerr << "tick rate " << tick_rate << " does not divide 1000 (e.g. 50, 100, 125, 200, 250, 500)"
+                  << std::endl;
+        return 1;
+    }
+    const int32_t tick_time = 1000 / tick_rate; // Длительность шага симуляции в миллисекундах
+    std::cout << "simulation " << tick_rate << " ticks/s, " << tick_time << " ms per tick" << std::endl;
+
+    sf::RenderWindow window(sf::VideoMode(c_window_width, c_window_height), "Blum");
+    // Частота кадров не влияет на симуляцию, поэтому ограничиваем ее только частотой монитора
+    window.setVerticalSyncEnabled(true);
+
+    // Камера поля: колесико мыши меняет масштаб, правая кнопка перемещает
+    sf::View camera(screen);
+    bool is_panning = false;
+    sf::Vector2i pan_start;
+
+    // Картинки декодируются в пуле потоков, а окно тем временем показывает экран загрузки.
+    // Ждем только ресурсы первого кадра, остальные догружаются во время игры
+    ThreadPool loader(0);
+    sf::Time load_start = startup_clock.getElapsedTime();
+    bool is_loaded = GameRenderer::start_loading(pack_path, &loader);
+    std::size_t decoding = GameRenderer::get_pending_resources(TextureAtlas::Priority::FirstFrame);
+    while (window.isOpen() && !GameRenderer::is_loaded(TextureAtlas::Priority::FirstFrame))
+    {
+        sf::Event event;
+        while (window.pollEvent(event))
+        {
+            if (event.type == sf::Event::Closed)
+                window.close();
+        }
+
+        std::size_t pending = GameRenderer::get_pending_resources(TextureAtlas::Priority::FirstFrame);
+        draw_loading(window, 1.f - static_cast<float>(pending) / std::max<std::size_t>(decoding, 1));
+    }
+    if (!window.isOpen())
+        return 0;
+
+    if (!GameRenderer::finish_loading(TextureAtlas::Priority::FirstFrame))
+        is_loaded = false;
+    if (!is_loaded)
     {
         std::cout << "trouble" << std::endl;
     }
-    GameRenderer game_renderer(game_board);
+    sf::Time load_time = startup_clock.getElapsedTime() - load_start;
+    bool is_deferred_loaded = false;
+    bool is_first_frame = true;
+    GameRenderer game_renderer(game_board, screen);
+    if (!replay_path.empty() && !game_renderer.start_recording(replay_path, tick_time))
+    {
+        std::cout << "cannot record replay to " << replay_path << std::endl;
+    }
     sf::Clock clock; // Часы для отслеживания времени
 
+    int32_t sim_time = 0;       // Время симуляции (кратно длительности шага)
+    int32_t accumulator = 0;    // Накопленное, но еще не просимулированное время
+    int32_t last_time = clock.getElapsedTime().asMilliseconds();
+    game_renderer.update(sim_time); // Начальное состояние
+
     while (window.isOpen())
     {
+        // Текстуры остальных ресурсов создаются, как только картинки декодированы
+        if (!is_deferred_loaded && GameRenderer::is_loaded(TextureAtlas::Priority::Deferred))
+        {
+            if (!GameRenderer::finish_loading(TextureAtlas::Priority::Deferred))
+            {
+                std::cout << "trouble" << std::endl;
+            }
+            if (print_timings)
+            {
+                for (const TextureAtlas::LoadTiming& timing : GameRenderer::get_load_timings())
+                    std::cout << "load " << timing.name << ": " << timing.microseconds << " us"
+                              << (timing.is_async ? " (thread pool)" : "") << std::endl;
+            }
+            is_deferred_loaded = true;
+        }
+
         sf::Event event;
         while (window.pollEvent(event))
         {
@@ -31,26 +197,76 @@ int main()
 
             if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
             {
-                sf::Vector2f mousePos(event.mouseButton.x, event.mouseButton.y);
-                game_renderer.click(mousePos);
+                // Клик переводится из пикселей окна в координаты поля
+                sf::Vector2i pixel(event.mouseButton.x, event.mouseButton.y);
+                game_renderer.click(window.mapPixelToCoords(pixel, camera));
+            }
+
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right)
+            {
+                is_panning = true;
+                pan_start = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+            }
+
+            if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Right)
+                is_panning = false;
+
+            if (event.type == sf::Event::MouseMoved && is_panning)
+            {
+                // Точка поля под курсором остается под курсором
+                sf::Vector2i pixel(event.mouseMove.x, event.mouseMove.y);
+                camera.move(window.mapPixelToCoords(pan_start, camera) - window.mapPixelToCoords(pixel, camera));
+                pan_start = pixel;
+            }
+
+            if (event.type == sf::Event::MouseWheelScrolled)
+            {
+                // Масштаб меняется относительно точки под курсором
+                sf::Vector2i pixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+                sf::Vector2f before = window.mapPixelToCoords(pixel, camera);
+                camera.zoom(event.mouseWheelScroll.delta > 0 ? 1.f / c_zoom_step : c_zoom_step);
+                camera.move(before - window.mapPixelToCoords(pixel, camera));
             }
         }
+
+        // Накапливаем прошедшее время и симулируем его шагами фиксированной длины
+        int32_t cur_time = clock.getElapsedTime().asMilliseconds();
+        accumulator += cur_time - last_time;
+        last_time = cur_time;
+        // После долгой паузы не пытаемся догнать все пропущенное время
+        accumulator = std::min(accumulator, c_max_ticks_per_frame * tick_time);
+
+        while (accumulator >= tick_time)
+        {
+            sim_time += tick_time;
+            game_renderer.update(sim_time);
+            accumulator -= tick_time;
+        }
+
         if (game_renderer.is_game_over())
         {
             window.close();
         }
 
-        // Обновление позиции объекта
-        int32_t cur_time = clock.getElapsedTime().asMilliseconds();
-        game_renderer.update(cur_time);
-        blum.move(cur_time);
+        // Отрисовываем состояние между двумя последними шагами симуляции
+        float alpha = static_cast<float>(accumulator) / tick_time;
+        int32_t render_time = std::max(0, sim_time - tick_time + accumulator);
         // Очистка окна
         window.clear();
+        window.setView(camera);
 
-        game_renderer.draw(window, cur_time);
-        blum.draw(window, cur_time);
+        game_renderer.draw(window, render_time, alpha);
         // Отображение окна
         window.display();
+
+        if (is_first_frame)
+        {
+            // Отчет о запуске: сколько заняла загрузка ресурсов и сколько картинок пришлось декодировать
+            std::cout << "startup " << startup_clock.getElapsedTime().asMilliseconds() << " ms to first frame, resources "
+                      << load_time.asMilliseconds() << " ms, " << GameRenderer::get_decoded_images()
+                      << " images decoded from files" << std::endl;
+            is_first_frame = false;
+        }
     }
 
     return 0;
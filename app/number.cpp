@@ -1,47 +1,46 @@
 #include "number.h"
 
+#include <cstdio>
+
 // Инициализация статического члена
-sf::Font Number::ms_font;
+GlyphFont Number::ms_font;
 
 Number::Number(const sf::FloatRect& rect, int n)
 {
-    // Установка шрифта для текста
-    m_text.setFont(ms_font);
-    // Установка размера шрифта для текста
-    m_text.setCharacterSize(mc_font_size);
+    reset(rect, n);
+}
+
+void Number::reset(const sf::FloatRect& rect, int n)
+{
+    // Сброс состояния после предыдущего использования
+    m_is_alive = true;
+    m_last_upgrade_time = -1;
 
     // Настройка текста в зависимости от значения n
     if (n < 0)
     {
-        // Если число отрицательное, просто отображаем его
-        m_text.setString(std::to_string(n));
         // Красный цвет для отрицательных чисел
         m_cur_text_color = sf::Color::Red;
     }
     else
     {
-        // Если число положительное, добавляем плюс перед числом
-        m_text.setString("+" + std::to_string(n));
         // Желтый цвет для положительных чисел
         m_cur_text_color = sf::Color::Yellow;
     }
-    // Установка стиля текста на жирный
-    m_text.setStyle(sf::Text::Bold);
-    // Установка цвета текста
-    m_text.setFillColor(m_cur_text_color);
+    // Отрицательное число выводится как есть, перед положительным добавляется плюс
+    std::snprintf(m_string.data(), m_string.size(), "%+d", n);
 
     // Центрирование текста в пределах заданного прямоугольника
-    sf::FloatRect textRect = m_text.getLocalBounds();
+    sf::FloatRect textRect = ms_font.get_bounds(m_string.data(), sf::Vector2f());
     float text_pos_x = rect.left + (rect.width - textRect.width) / 2.f;
     float text_pos_y = rect.top + (rect.height - textRect.height) / 2.f;
     m_cur_pos = sf::Vector2f(text_pos_x, text_pos_y);
-    m_text.setPosition(m_cur_pos);
 }
 
-bool Number::load_resources(void)
+bool Number::load_resources(TextureAtlas& atlas)
 {
-    // Загрузка ресурса шрифта из файла
-    return ms_font.loadFromFile("./src/Consolas.ttf");
+    // Растеризация символов шрифта (жирным) в атлас
+    return ms_font.load(atlas, "./src/Consolas.ttf", mc_font_size, true);
 }
 
 void Number::move(int32_t cur_time)
@@ -58,7 +57,6 @@ void Number::move(int32_t cur_time)
 
     // Обновление позиции числа по вертикали на основании времени
     m_cur_pos.y -= mc_move_speed * time_diff_sec;
-    m_text.setPosition(m_cur_pos);
 
     // Обновление альфа-канала (прозрачности) для постепенного исчезновения текста
     int alpha = static_cast<int>(m_cur_text_color.a - mc_alpha_change_speed * time_diff_sec);
@@ -68,16 +66,23 @@ void Number::move(int32_t cur_time)
         m_is_alive = false;
     }
     m_cur_text_color.a = static_cast<sf::Uint8>(alpha);
-    m_text.setFillColor(m_cur_text_color);
 
     // Обновление времени последнего обновления
     m_last_upgrade_time = cur_time;
 }
 
-void Number::draw(sf::RenderWindow& window) const
+void Number::draw(SpriteBatch& batch) const
+{
+    // Символы попадают в пакет прямоугольниками с цветом и прозрачностью числа
+    ms_font.draw(batch, SpriteBatch::Layer::Numbers, m_string.data(), m_cur_pos, 1.f, m_cur_text_color);
+}
+
+bool Number::is_visible(const sf::FloatRect& view_rect) const
 {
-    // Отрисовка текста в окне рендеринга
-    window.draw(m_text);
+    // Прозрачное число не рисуем, даже если оно еще не удалено
+    if (m_cur_text_color.a == 0)
+        return false;
+    return ms_font.get_bounds(m_string.data(), m_cur_pos).intersects(view_rect);
 }
 
 bool Number::get_status(void) const
@@ -2,6 +2,11 @@
 #define NUMBER_H
 
 #include <SFML/Graphics.hpp>
+#include <array>
+
+#include "glyphfont.h"
+#include "spritebatch.h"
+#include "textureatlas.h"
 
 /**
  * @class Number
@@ -22,11 +27,22 @@ public:
      */
     explicit Number(const sf::FloatRect& rect, int n);
 
+    /**
+     * @brief Повторно инициализирует число, как это делает параметризированный конструктор.
+     *
+     * Позволяет переиспользовать объект из пула вместо создания нового.
+     *
+     * @param rect Начальная позиция и размер числа.
+     * @param n Целое число, которое будет отображаться.
+     */
+    void reset(const sf::FloatRect& rect, int n);
+
     /**
      * @brief Загружает необходимые ресурсы для класса Number.
+     * @param atlas Атлас текстур, в который добавляются символы шрифта.
      * @return true, если ресурсы успешно загружены, иначе false.
      */
-    static bool load_resources(void);
+    static bool load_resources(TextureAtlas& atlas);
 
     /**
      * @brief Перемещает число на основе текущего времени.
@@ -35,10 +51,17 @@ public:
     void move(int32_t cur_time);
 
     /**
-     * @brief Рисует число на указанном окне рендеринга.
-     * @param window Окно рендеринга SFML, на котором будет нарисовано число.
+     * @brief Добавляет число в слой чисел пакета отрисовки.
+     * @param batch Пакет отрисовки.
+     */
+    void draw(SpriteBatch& batch) const;
+
+    /**
+     * @brief Проверяет, будет ли число видно в заданной области.
+     * @param view_rect Видимая область поля.
+     * @return false, если число полностью прозрачно или вне области, иначе true.
      */
-    void draw(sf::RenderWindow& window) const;
+    bool is_visible(const sf::FloatRect& view_rect) const;
 
     /**
      * @brief Проверяет, активен ли номер.
@@ -49,13 +72,13 @@ public:
 private:
     bool m_is_alive = true; /**< Указывает, активен ли номер. */
     sf::Vector2f m_cur_pos; /**< Текущее положение номера. */
-    sf::Text m_text; /**< Объект текста SFML, представляющий номер. */
-    const float mc_alpha_change_speed = 100.f; /**< Скорость, с которой номер исчезает. */
-    const float mc_move_speed = 20.f; /**< Скорость, с которой номер перемещается. */
-    const std::size_t mc_font_size = 32; /**< Размер шрифта номера. */
+    std::array<char, 16> m_string{}; /**< Текст номера (строка с нулем в конце). */
+    static constexpr float mc_alpha_change_speed = 100.f; /**< Скорость, с которой номер исчезает. */
+    static constexpr float mc_move_speed = 20.f; /**< Скорость, с которой номер перемещается. */
+    static constexpr unsigned mc_font_size = 32; /**< Размер шрифта номера. */
     int32_t m_last_upgrade_time = -1; /**< Время последнего обновления для плавного движения/исчезновения. */
     sf::Color m_cur_text_color; /**< Текущий цвет текста. */
-    static sf::Font ms_font; /**< Статический шрифт, используемый для рендеринга номера. */
+    static GlyphFont ms_font; /**< Статический растровый шрифт, используемый для рендеринга номера. */
 };
 
 #endif // NUMBER_H
@@ -57,15 +57,122 @@ sf::Vector2f ObjectLogic::move(int32_t cur_time)
     return m_cur_position;
 }
 
+// ======================================================
+// ===================== ObjectSkin =====================
+// ======================================================
+ObjectSkin::ObjectSkin(const std::vector<AtlasFrame>& glow_frames, int32_t glow_change_time,
+                       const std::vector<AtlasFrame>& activ_frames, int32_t activ_change_time,
+                       const std::vector<AtlasFrame>& idle_frames, int32_t idle_change_time)
+    : m_glow_anim(glow_frames, glow_change_time),
+      m_activ_anim(activ_frames, activ_change_time),
+      m_idle_anim(idle_frames, idle_change_time)
+{
+
+}
+
+void ObjectSkin::resize(const sf::Vector2f& new_size)
+{
+    m_glow_anim.resize(new_size);
+    m_activ_anim.resize(new_size);
+    m_idle_anim.resize(new_size);
+}
+
+void ObjectSkin::prepare_geometry(void)
+{
+    m_glow_anim.prepare_geometry();
+    m_activ_anim.prepare_geometry();
+    m_idle_anim.prepare_geometry();
+}
+
+void ObjectSkin::start_activation(int32_t cur_time)
+{
+    m_activ_anim.start(cur_time); // Запускаем активную анимацию.
+}
+
+void ObjectSkin::restart(int32_t cur_time)
+{
+    m_glow_anim.start(cur_time);
+    m_activ_anim.start(cur_time);
+    m_idle_anim.start(cur_time);
+}
+
+void ObjectSkin::schedule(AnimationScheduler& scheduler, int32_t cur_time)
+{
+    m_glow_anim.schedule(scheduler, true, cur_time);
+    m_activ_anim.schedule(scheduler, false, -1); // Активация начнется при нажатии
+    m_idle_anim.schedule(scheduler, true, cur_time);
+}
+
+void ObjectSkin::unschedule(void)
+{
+    m_glow_anim.unschedule();
+    m_activ_anim.unschedule();
+    m_idle_anim.unschedule();
+}
+
+bool ObjectSkin::is_drawn(bool activated, int32_t cur_time) const
+{
+    // Нажатый объект после окончания анимации активации не рисуется
+    return !activated || !m_activ_anim.is_end(cur_time);
+}
+
+bool ObjectSkin::draw(SpriteBatch& batch, const sf::FloatRect& rec, bool activated, int32_t cur_time)
+{
+    if (activated) //  Объект был нажат (активирован)
+    {
+        if (m_activ_anim.is_end(cur_time)) // Если закончилась анимация
+        {
+            return false;
+        }
+
+        m_activ_anim.draw(batch, SpriteBatch::Layer::Objects, sf::Vector2f(rec.left, rec.top), cur_time);
+    }
+    else // Объект жив
+    {
+        m_idle_anim.draw(batch, SpriteBatch::Layer::Objects, sf::Vector2f(rec.left, rec.top), cur_time);
+        // Свечение чуть выше объекта
+        m_glow_anim.draw(batch, SpriteBatch::Layer::Objects, sf::Vector2f(rec.left, rec.top - rec.height / 2.f), cur_time);
+    }
+    return true;
+}
+
+const sf::Texture* ObjectSkin::build(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rec, bool activated,
+                                     int32_t cur_time)
+{
+    if (activated) //  Объект был нажат (активирован)
+    {
+        if (m_activ_anim.is_end(cur_time)) // Если закончилась анимация
+            return nullptr;
+        return m_activ_anim.build(vertices, sf::Vector2f(rec.left, rec.top), cur_time);
+    }
+
+    // Объект жив: кадр покоя и свечение чуть выше объекта
+    std::size_t size = vertices.size();
+    const sf::Texture* texture = m_idle_anim.build(vertices, sf::Vector2f(rec.left, rec.top), cur_time);
+    const sf::Texture* glow_texture = m_glow_anim.build(vertices, sf::Vector2f(rec.left, rec.top - rec.height / 2.f), cur_time);
+    if (texture == nullptr || glow_texture != texture)
+    {
+        vertices.resize(size);
+        return nullptr;
+    }
+    return texture;
+}
+
 // ==================================================
 // ===================== Object =====================
 // ==================================================
-Object::Object(sf::Texture& glow_tex, std::size_t glow_n, int32_t glow_change_time,
-               sf::Texture& activ_tex, std::size_t activ_n, int32_t activ_change_time,
-               sf::Texture& idle_tex, std::size_t idle_n, int32_t idle_change_time)
-    : m_glow_anim(glow_tex, glow_n, glow_change_time),
-      m_activ_anim(activ_tex, activ_n, activ_change_time),
-      m_idle_anim(idle_tex, idle_n, idle_change_time)
+Object::Object(const std::vector<AtlasFrame>& glow_frames, int32_t glow_change_time,
+               const std::vector<AtlasFrame>& activ_frames, int32_t activ_change_time,
+               const std::vector<AtlasFrame>& idle_frames, int32_t idle_change_time)
+    : m_skin(glow_frames, glow_change_time,
+             activ_frames, activ_change_time,
+             idle_frames, idle_change_time)
+{
+
+}
+
+Object::Object(ObjectSkin&& skin)
+    : m_skin(std::move(skin))
 {
 
 }
@@ -87,9 +194,7 @@ void Object::set_position(const sf::Vector2f& new_pos)
 
 void Object::set_size(const sf::Vector2f& new_size)
 {
-    m_glow_anim.resize(new_size);
-    m_activ_anim.resize(new_size);
-    m_idle_anim.resize(new_size);
+    m_skin.resize(new_size);
 
     ObjectLogic::set_size(new_size);
 }
@@ -113,38 +218,17 @@ bool Object::try_press(const sf::Vector2f& mouse_pos)
 {
     if (check_collision(mouse_pos) && !m_activated) // Есть пересечение и этот объект еще не активирован
     {
-        m_activ_anim.start(); // Запускаем активную анимацию.
+        m_skin.start_activation(); // Запускаем активную анимацию.
         m_activated = true; // Активируем объект
         return true;
     }
     return false;
 }
 
-void Object::draw(sf::RenderWindow& window, int32_t cur_time)
+void Object::draw(SpriteBatch& batch, int32_t cur_time)
 {
-    sf::FloatRect rec = get_rect();
-
-    if (m_activated) //  Объект был нажат (активирован)
-    {
-        if (m_activ_anim.is_end(cur_time)) // Если закончилась анимация
-        {
-            m_alive = false; // Помечаем объект как неактивный (мертвый).
-            return;
-        }
-
-        sf::Sprite sprite = m_activ_anim.get_sprite(cur_time); // Получаем спрайт текущего кадра активной анимации.
-        sprite.setPosition(rec.left, rec.top); // Перемещаем спрайт активной анимации на его позицию.
-        window.draw(sprite); // Отрисовываем спрайт активной анимации.
-    }
-    else // Объект жив
+    if (!m_skin.draw(batch, get_rect(), m_activated, cur_time)) // Закончилась анимация активации
     {
-        sf::Sprite sprite = m_idle_anim.get_sprite(cur_time); // Получаем спрайт текущего кадра анимации покоя.
-        sf::Sprite glow = m_glow_anim.get_sprite(cur_time); // Получаем спрайт текущего кадра анимации свечения.
-        sprite.setPosition(rec.left, rec.top); // Перемещаем обычный спрайт на его позицию.
-        glow.setPosition(rec.left, rec.top - rec.height / 2.f); // Перемещаем спрайт свечения чуть выше, чем позиция.
-        window.draw(sprite); // Отрисовываем спрайт анимации покоя.
-        window.draw(glow); // Отрисовываем спрайт анимации свечения.
+        m_alive = false; // Помечаем объект как неактивный (мертвый).
     }
 }
-
-
@@ -5,6 +5,7 @@
 #include <cmath>
 
 #include "animation.h"
+#include "spritebatch.h"
 
 /**
  * @brief Класс для логики объекта.
@@ -102,6 +103,135 @@ private:
     int32_t m_last_update_time = -1;    ///< Время последнего обновления состояния объекта.
 };
 
+/**
+ * @brief Класс внешнего вида объекта.
+ *
+ * Хранит анимации свечения, активации и бездействия и умеет отрисовывать их
+ * в заданном прямоугольнике. Не хранит ни положения, ни состояния объекта,
+ * поэтому может использоваться вместе с внешним хранилищем сущностей.
+ */
+class ObjectSkin
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit ObjectSkin(void) = default;
+
+    /**
+     * @brief Конструктор с параметрами.
+     *
+     * @param glow_frames Кадры анимации свечения.
+     * @param glow_change_time Время смены спрайтов в анимации свечения.
+     * @param activ_frames Кадры анимации активации.
+     * @param activ_change_time Время смены спрайтов в анимации активации.
+     * @param idle_frames Кадры анимации бездействия.
+     * @param idle_change_time Время смены спрайтов в анимации бездействия.
+     */
+    explicit ObjectSkin(const std::vector<AtlasFrame>& glow_frames, int32_t glow_change_time,
+                        const std::vector<AtlasFrame>& activ_frames, int32_t activ_change_time,
+                        const std::vector<AtlasFrame>& idle_frames, int32_t idle_change_time);
+
+    /**
+     * @brief Конструктор перемещения.
+     */
+    ObjectSkin(ObjectSkin&& other) noexcept = default;
+
+    /**
+     * @brief Оператор присваивания перемещением.
+     */
+    ObjectSkin& operator=(ObjectSkin&& other) noexcept = default;
+
+    /**
+     * @brief Изменить размер всех анимаций.
+     *
+     * @param new_size Новый размер объекта.
+     */
+    void resize(const sf::Vector2f& new_size);
+
+    /**
+     * @brief Заранее берет из кэша вершины кадров всех анимаций в текущем размере.
+     */
+    void prepare_geometry(void);
+
+    /**
+     * @brief Запустить анимацию активации с начала.
+     * @param cur_time Время нажатия в миллисекундах (-1 - время первой отрисовки).
+     */
+    void start_activation(int32_t cur_time = -1);
+
+    /**
+     * @brief Перезапустить все анимации с начала.
+     *
+     * Используется при повторном использовании внешнего вида из пула.
+     *
+     * @param cur_time Время появления объекта в миллисекундах (-1 - время первой отрисовки).
+     */
+    void restart(int32_t cur_time = -1);
+
+    /**
+     * @brief Передает часы всех анимаций планировщику.
+     *
+     * Анимации покоя и свечения начинаются в cur_time, а анимация
+     * активации ждет start_activation.
+     *
+     * @param scheduler Планировщик анимаций.
+     * @param cur_time Время появления объекта в миллисекундах.
+     */
+    void schedule(AnimationScheduler& scheduler, int32_t cur_time);
+
+    /**
+     * @brief Удаляет анимации из планировщика (например, при возврате в пул).
+     */
+    void unschedule(void);
+
+    /**
+     * @brief Проверяет, есть ли у объекта что рисовать.
+     * @param activated Активирован ли объект.
+     * @param cur_time Текущее время для анимации.
+     * @return false, если анимация активации закончилась, иначе true.
+     */
+    bool is_drawn(bool activated, int32_t cur_time) const;
+
+    /**
+     * @brief Добавление объекта в пакет отрисовки.
+     *
+     * Для активированного объекта добавляет кадр анимации активации,
+     * иначе - кадры анимаций покоя и свечения. Кадры добавляются в слой
+     * объектов пакета и рисуются вместе с кадрами других объектов.
+     *
+     * @param batch Пакет отрисовки.
+     * @param rect Границы объекта.
+     * @param activated Активирован ли объект.
+     * @param cur_time Текущее время для анимации.
+     * @return false, если анимация активации закончилась, иначе true.
+     */
+    bool draw(SpriteBatch& batch, const sf::FloatRect& rect, bool activated, int32_t cur_time);
+
+    /**
+     * @brief Запись объекта в массив вершин (те же кадры, что у draw).
+     *
+     * Используется для постоянного буфера вершин, который рисуется с одной
+     * текстурой, поэтому вершины добавляются, только если все кадры объекта
+     * лежат на одной странице атласа.
+     *
+     * @param vertices Куда добавить вершины (не больше mc_max_vertices).
+     * @param rect Границы объекта.
+     * @param activated Активирован ли объект.
+     * @param cur_time Текущее время для анимации.
+     * @return Текстура кадров или nullptr, если вершины не добавлены.
+     */
+    const sf::Texture* build(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, bool activated,
+                             int32_t cur_time);
+
+    static constexpr std::size_t mc_max_vertices = 12; ///< Наибольшее количество вершин объекта (два прямоугольника).
+
+private:
+    Animation m_glow_anim;          ///< Анимация свечения объекта.
+    Animation m_activ_anim;         ///< Анимация активации объекта.
+    Animation m_idle_anim;          ///< Анимация бездействия объекта.
+};
+
 /**
  * @brief Класс объекта с анимацией, который наследует логику из ObjectLogic и добавляет графический интерфейс
  *
@@ -119,19 +249,23 @@ public:
     /**
      * @brief Конструктор с параметрами.
      *
-     * @param glow_tex Текстура для анимации свечения.
-     * @param glow_n Количество спрайтов в анимации свечения.
+     * @param glow_frames Кадры анимации свечения.
      * @param glow_change_time Время смены спрайтов в анимации свечения.
-     * @param activ_tex Текстура для анимации активации.
-     * @param activ_n Количество спрайтов в анимации активации.
+     * @param activ_frames Кадры анимации активации.
      * @param activ_change_time Время смены спрайтов в анимации активации.
-     * @param idle_tex Текстура для анимации бездействия.
-     * @param idle_n Количество спрайтов в анимации бездействия.
+     * @param idle_frames Кадры анимации бездействия.
      * @param idle_change_time Время смены спрайтов в анимации бездействия.
      */
-    explicit Object(sf::Texture& glow_tex, std::size_t glow_n, int32_t glow_change_time,
-                    sf::Texture& activ_tex, std::size_t activ_n, int32_t activ_change_time,
-                    sf::Texture& idle_tex, std::size_t idle_n, int32_t idle_change_time);
+    explicit Object(const std::vector<AtlasFrame>& glow_frames, int32_t glow_change_time,
+                    const std::vector<AtlasFrame>& activ_frames, int32_t activ_change_time,
+                    const std::vector<AtlasFrame>& idle_frames, int32_t idle_change_time);
+
+    /**
+     * @brief Конструктор из готового внешнего вида.
+     *
+     * @param skin Внешний вид (набор анимаций) объекта.
+     */
+    explicit Object(ObjectSkin&& skin);
 
     /**
      * @brief Виртуальный деструктор по умолчанию.
@@ -214,20 +348,18 @@ public:
     bool try_press(const sf::Vector2f& mouse_pos);
 
     /**
-     * @brief Отрисовка объекта в окне.
+     * @brief Добавление объекта в пакет отрисовки.
      *
-     * Если активная анимация выполняется, рисует спрайт этой анимации.
-     * В противном случае отрисовывает спрайты для анимации покоя и свечения.
+     * Если активная анимация выполняется, добавляет кадр этой анимации.
+     * В противном случае добавляет кадры анимаций покоя и свечения.
      *
-     * @param window Окно для отрисовки.
+     * @param batch Пакет отрисовки.
      * @param cur_time Текущее время для анимации.
      */
-    void draw(sf::RenderWindow& window, int32_t cur_time);
+    void draw(SpriteBatch& batch, int32_t cur_time);
 
 private:
-    Animation m_glow_anim;          ///< Анимация свечения объекта.
-    Animation m_activ_anim;         ///< Анимация активации объекта.
-    Animation m_idle_anim;          ///< Анимация бездействия объекта.
+    ObjectSkin m_skin;              ///< Внешний вид (анимации) объекта.
     bool m_alive = true;            ///< Статус объекта (жив или нет).
     bool m_activated = false;       ///< Статус объекта (активирован или нет).
 };
@@ -0,0 +1,115 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Пул переиспользуемых объектов со списком свободных элементов.
+ *
+ * Объекты никогда не уничтожаются: освобожденный элемент попадает в список
+ * свободных и при следующем запросе отдается повторно. Сбрасывать его
+ * состояние должен вызывающий код. Новые объекты создаются только тогда,
+ * когда свободных не осталось.
+ *
+ * @tparam T Тип объектов пула (должен поддерживать перемещение).
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit ObjectPool(void) = default;
+
+    /**
+     * @brief Резервирует память под заданное количество объектов.
+     * @param capacity Ожидаемое количество одновременно используемых объектов.
+     */
+    void reserve(std::size_t capacity)
+    {
+        m_items.reserve(capacity);
+        m_free.reserve(capacity);
+    }
+
+    /**
+     * @brief Выдает объект из пула.
+     *
+     * Если есть свободный объект, возвращается он (в том состоянии, в котором
+     * был освобожден), иначе создается новый с помощью фабрики.
+     *
+     * @tparam Factory Функция без параметров, возвращающая новый объект T.
+     * @param make Фабрика новых объектов.
+     * @return Номер выданного объекта.
+     */
+    template <typename Factory>
+    std::uint32_t acquire(Factory&& make)
+    {
+        if (!m_free.empty())
+        {
+            std::uint32_t id = m_free.back();
+            m_free.pop_back();
+            return id;
+        }
+
+        m_items.push_back(make());
+        ++m_created_count;
+        return static_cast<std::uint32_t>(m_items.size() - 1);
+    }
+
+    /**
+     * @brief Возвращает объект в пул.
+     * @param id Номер объекта, полученный из acquire.
+     */
+    void release(std::uint32_t id)
+    {
+        m_free.push_back(id);
+    }
+
+    /**
+     * @brief Получить объект по номеру.
+     * @param id Номер объекта.
+     * @return Ссылка на объект.
+     */
+    T& get(std::uint32_t id)
+    {
+        return m_items[id];
+    }
+
+    /**
+     * @brief Получить объект по номеру.
+     * @param id Номер объекта.
+     * @return Константная ссылка на объект.
+     */
+    const T& get(std::uint32_t id) const
+    {
+        return m_items[id];
+    }
+
+    /**
+     * @brief Количество объектов, созданных пулом за все время.
+     * @return Количество созданных объектов.
+     */
+    std::size_t get_created_count(void) const
+    {
+        return m_created_count;
+    }
+
+    /**
+     * @brief Количество свободных объектов в пуле.
+     * @return Количество свободных объектов.
+     */
+    std::size_t get_free_count(void) const
+    {
+        return m_free.size();
+    }
+
+private:
+    std::vector<T> m_items;             ///< Все объекты пула.
+    std::vector<std::uint32_t> m_free;  ///< Номера свободных объектов.
+    std::size_t m_created_count = 0;    ///< Количество созданных объектов.
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,247 @@
+#include "spritebatch.h"
+
+#include <cmath>
+
+// Начало нового кадра
+void SpriteBatch::clear(void)
+{
+    // Пакеты текстур остаются, у массивов вершин сохраняется выделенная память
+    for (LayerData& layer : m_layers)
+    {
+        for (Batch& batch : layer.batches)
+            batch.vertices.clear();
+        layer.drawables.clear();
+        layer.used = 0;
+    }
+    m_draw_list.clear();
+    m_draw_calls = 0;
+    m_quads = 0;
+    m_state_changes = 0;
+    m_has_state = false;
+}
+
+// Добавление прямоугольника с текстурой
+void SpriteBatch::add(Layer layer, const sf::Texture& texture, const sf::FloatRect& rect, const sf::IntRect& tex_rect,
+                      const sf::Color& color, const sf::BlendMode& blend)
+{
+    Batch& batch = get_batch(layer, &texture, blend);
+    append_quad(batch.vertices, rect, tex_rect, color);
+}
+
+// Добавление готовых вершин
+void SpriteBatch::add(Layer layer, const sf::Texture& texture, const std::vector<sf::Vertex>& vertices,
+                      const sf::BlendMode& blend)
+{
+    Batch& batch = get_batch(layer, &texture, blend);
+    batch.vertices.insert(batch.vertices.end(), vertices.begin(), vertices.end());
+}
+
+// Добавление готовых вершин со смещением
+void SpriteBatch::add(Layer layer, const sf::Texture& texture, const sf::Vertex* vertices, std::size_t count,
+                      const sf::Vector2f& offset, const sf::BlendMode& blend)
+{
+    Batch& batch = get_batch(layer, &texture, blend);
+    append_vertices(batch.vertices, vertices, count, offset);
+}
+
+// Запись прямоугольника двумя треугольниками
+void SpriteBatch::append_quad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, const sf::IntRect& tex_rect,
+                              const sf::Color& color)
+{
+    float left = rect.left;
+    float top = rect.top;
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+
+    float tex_left = static_cast<float>(tex_rect.left);
+    float tex_top = static_cast<float>(tex_rect.top);
+    float tex_right = static_cast<float>(tex_rect.left + tex_rect.width);
+    float tex_bottom = static_cast<float>(tex_rect.top + tex_rect.height);
+
+    // Два треугольника: левый верхний - правый верхний - левый нижний и правый верхний - правый нижний - левый нижний
+    vertices.emplace_back(sf::Vector2f(left, top), color, sf::Vector2f(tex_left, tex_top));
+    vertices.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(tex_right, tex_top));
+    vertices.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(tex_left, tex_bottom));
+    vertices.emplace_back(sf::Vector2f(right, top), color, sf::Vector2f(tex_right, tex_top));
+    vertices.emplace_back(sf::Vector2f(right, bottom), color, sf::Vector2f(tex_right, tex_bottom));
+    vertices.emplace_back(sf::Vector2f(left, bottom), color, sf::Vector2f(tex_left, tex_bottom));
+}
+
+// Запись вершин со смещением
+void SpriteBatch::append_vertices(std::vector<sf::Vertex>& dest, const sf::Vertex* vertices, std::size_t count,
+                                  const sf::Vector2f& offset)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dest.emplace_back(vertices[i].position + offset, vertices[i].color, vertices[i].texCoords);
+}
+
+// Добавление кадра атласа
+void SpriteBatch::add(Layer layer, const AtlasFrame& frame, const sf::FloatRect& rect, const sf::Color& color,
+                      const sf::BlendMode& blend)
+{
+    if (frame.texture == nullptr)
+        return;
+    add(layer, *frame.texture, rect, frame.rect, color, blend);
+}
+
+// Добавление объекта, который рисуется отдельно
+void SpriteBatch::add(Layer layer, const sf::Drawable& drawable)
+{
+    m_layers[static_cast<std::size_t>(layer)].drawables.push_back(&drawable);
+}
+
+// Отрисовка всех слоев
+void SpriteBatch::draw(sf::RenderTarget& target, Layer first, Layer last)
+{
+    for (std::size_t i = static_cast<std::size_t>(first); i <= static_cast<std::size_t>(last); ++i)
+    {
+        const LayerData& layer = m_layers[i];
+        Layer layer_id = static_cast<Layer>(i);
+
+        // Сначала пакет с уже установленным состоянием, чтобы не переключать его на стыке слоев
+        // (кроме слоя, где важен порядок добавления)
+        std::size_t first_batch = layer.batches.size();
+        for (std::size_t b = 0; b < layer.batches.size() && m_has_state && !keeps_order(layer_id); ++b)
+        {
+            const Batch& batch = layer.batches[b];
+            if (batch.texture == m_texture && batch.blend == m_blend && !batch.vertices.empty())
+            {
+                first_batch = b;
+                break;
+            }
+        }
+        if (first_batch < layer.batches.size())
+            submit(target, layer_id, layer.batches[first_batch]);
+
+        // Все прямоугольники одного состояния - одним вызовом
+        for (std::size_t b = 0; b < layer.batches.size(); ++b)
+        {
+            if (b != first_batch)
+                submit(target, layer_id, layer.batches[b]);
+        }
+
+        for (const sf::Drawable* drawable : layer.drawables)
+        {
+            target.draw(*drawable);
+            m_draw_list.push_back(DrawCall{layer_id, nullptr, 0});
+            ++m_draw_calls;
+            // Объект сам выбирает текстуру, поэтому состояние после него неизвестно
+            ++m_state_changes;
+            m_has_state = false;
+        }
+    }
+}
+
+// Отрисовка одного пакета
+void SpriteBatch::submit(sf::RenderTarget& target, Layer layer, const Batch& batch)
+{
+    std::size_t count = batch.vertices.size();
+    if (count == 0)
+        return;
+
+    if (!m_has_state || batch.texture != m_texture || batch.blend != m_blend)
+    {
+        ++m_state_changes;
+        m_texture = batch.texture;
+        m_blend = batch.blend;
+        m_has_state = true;
+    }
+
+    sf::RenderStates states(batch.texture);
+    states.blendMode = batch.blend;
+    target.draw(batch.vertices.data(), count, sf::Triangles, states);
+    m_draw_list.push_back(DrawCall{layer, batch.texture, count / 6});
+    ++m_draw_calls;
+    m_quads += count / 6;
+}
+
+// Количество вызовов отрисовки
+std::size_t SpriteBatch::get_draw_calls(void) const
+{
+    return m_draw_calls;
+}
+
+// Количество прямоугольников
+std::size_t SpriteBatch::get_quad_count(void) const
+{
+    return m_quads;
+}
+
+// Количество смен состояния
+std::size_t SpriteBatch::get_state_changes(void) const
+{
+    return m_state_changes;
+}
+
+// Список вызовов отрисовки
+const std::vector<SpriteBatch::DrawCall>& SpriteBatch::get_draw_list(void) const
+{
+    return m_draw_list;
+}
+
+// Сохраняет ли слой порядок добавления
+bool SpriteBatch::keeps_order(Layer layer)
+{
+    // Текст меток рисуется поверх их картинок, а страницы атласа у них могут быть разными
+    return layer == Layer::Labels;
+}
+
+// Площадь прямоугольников
+std::size_t SpriteBatch::get_pixel_count(void) const
+{
+    // Вершины не удаляются до следующего clear, поэтому считаем по ним, не нагружая add
+    double pixels = 0.0;
+    for (const LayerData& layer : m_layers)
+    {
+        for (const Batch& batch : layer.batches)
+            pixels += get_quads_area(batch.vertices.data(), batch.vertices.size());
+    }
+    return static_cast<std::size_t>(pixels);
+}
+
+// Площадь прямоугольников массива вершин
+double SpriteBatch::get_quads_area(const sf::Vertex* vertices, std::size_t count)
+{
+    double area = 0.0;
+    for (std::size_t i = 0; i + 5 < count; i += 6)
+    {
+        float width = vertices[i + 1].position.x - vertices[i].position.x;
+        float height = vertices[i + 2].position.y - vertices[i].position.y;
+        area += std::fabs(static_cast<double>(width) * height);
+    }
+    return area;
+}
+
+// Поиск пакета состояния
+SpriteBatch::Batch& SpriteBatch::get_batch(Layer layer, const sf::Texture* texture, const sf::BlendMode& blend)
+{
+    LayerData& data = m_layers[static_cast<std::size_t>(layer)];
+    if (keeps_order(layer))
+    {
+        // Продолжаем последний пакет, иначе занимаем следующий (его вершины уже очищены в clear)
+        if (data.used > 0)
+        {
+            Batch& last = data.batches[data.used - 1];
+            if (last.texture == texture && last.blend == blend)
+                return last;
+        }
+        if (data.used == data.batches.size())
+            data.batches.emplace_back();
+        Batch& batch = data.batches[data.used++];
+        batch.texture = texture;
+        batch.blend = blend;
+        return batch;
+    }
+
+    // Состояний в слое единицы, поэтому линейного поиска достаточно
+    for (Batch& batch : data.batches)
+    {
+        if (batch.texture == texture && batch.blend == blend)
+            return batch;
+    }
+
+    data.batches.emplace_back();
+    data.batches.back().texture = texture;
+    data.batches.back().blend = blend;
+    return data.batches.back();
+}
@@ -0,0 +1,263 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <vector>
+
+#include "textureatlas.h"
+
+/**
+ * @brief Пакетная отрисовка спрайтов: один вызов отрисовки на состояние слоя.
+ *
+ * За кадр в пакет добавляются команды - прямоугольники (quad) с текстурой и
+ * режимом смешивания, - а в конце кадра draw отрисовывает их по слоям: все
+ * прямоугольники слоя с одинаковыми текстурой и режимом смешивания собраны
+ * в один массив вершин и рисуются одним вызовом. Порядок слоев сохраняется,
+ * внутри слоя прямоугольники группируются по состояниям. Первым в слое
+ * рисуется пакет с тем же состоянием, что у последнего вызова предыдущего
+ * слоя, поэтому на стыке слоев текстура не переключается.
+ *
+ * В слое меток (keeps_order) прямоугольники с разными текстурами
+ * перекрываются (текст лежит на картинке), поэтому там сохраняется порядок
+ * добавления: в пакет объединяются только идущие подряд прямоугольники
+ * одного состояния.
+ *
+ * То, что нельзя собрать в пакет (например, sf::Text), добавляется как
+ * sf::Drawable и рисуется после прямоугольников своего слоя.
+ *
+ * Массивы вершин не освобождаются между кадрами, поэтому в установившемся
+ * режиме пакет не выделяет память.
+ */
+class SpriteBatch
+{
+public:
+    /**
+     * @brief Слои отрисовки (в порядке отрисовки).
+     */
+    enum class Layer
+    {
+        Background, ///< Задний фон.
+        Objects,    ///< Игровые объекты.
+        Numbers,    ///< Всплывающие числа.
+        Overlay,    ///< Анимация заморозки поверх поля.
+        Labels      ///< Метки счета и таймера.
+    };
+
+    /**
+     * @brief Вызов отрисовки из последнего draw.
+     */
+    struct DrawCall
+    {
+        Layer layer;                ///< Слой вызова.
+        const sf::Texture* texture; ///< Текстура (nullptr - объект sf::Drawable).
+        std::size_t quads;          ///< Количество прямоугольников.
+    };
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit SpriteBatch(void) = default;
+
+    /**
+     * @brief Начинает новый кадр: удаляет все добавленное, сохраняя выделенную память.
+     */
+    void clear(void);
+
+    /**
+     * @brief Добавляет прямоугольник с текстурой.
+     * @param layer Слой отрисовки.
+     * @param texture Текстура.
+     * @param rect Прямоугольник на экране.
+     * @param tex_rect Прямоугольник в текстуре (в пикселях).
+     * @param color Цвет, на который умножается текстура.
+     * @param blend Режим смешивания.
+     */
+    void add(Layer layer, const sf::Texture& texture, const sf::FloatRect& rect, const sf::IntRect& tex_rect,
+             const sf::Color& color = sf::Color::White, const sf::BlendMode& blend = sf::BlendAlpha);
+
+    /**
+     * @brief Добавляет кадр атласа, растянутый на прямоугольник.
+     *
+     * Незагруженный кадр (без текстуры) пропускается.
+     *
+     * @param layer Слой отрисовки.
+     * @param frame Кадр в атласе текстур.
+     * @param rect Прямоугольник на экране.
+     * @param color Цвет, на который умножается текстура.
+     * @param blend Режим смешивания.
+     */
+    void add(Layer layer, const AtlasFrame& frame, const sf::FloatRect& rect, const sf::Color& color = sf::Color::White,
+             const sf::BlendMode& blend = sf::BlendAlpha);
+
+    /**
+     * @brief Добавляет готовые вершины (например, сохраненные с прошлого кадра).
+     * @param layer Слой отрисовки.
+     * @param texture Текстура.
+     * @param vertices Вершины треугольников (по шесть на прямоугольник, см. append_quad).
+     * @param blend Режим смешивания.
+     */
+    void add(Layer layer, const sf::Texture& texture, const std::vector<sf::Vertex>& vertices,
+             const sf::BlendMode& blend = sf::BlendAlpha);
+
+    /**
+     * @brief Добавляет готовые вершины, сдвинутые на заданное смещение.
+     * @param layer Слой отрисовки.
+     * @param texture Текстура.
+     * @param vertices Вершины треугольников (например, кадр из FrameGeometryCache).
+     * @param count Количество вершин.
+     * @param offset Смещение, прибавляемое к позициям вершин.
+     * @param blend Режим смешивания.
+     */
+    void add(Layer layer, const sf::Texture& texture, const sf::Vertex* vertices, std::size_t count,
+             const sf::Vector2f& offset, const sf::BlendMode& blend = sf::BlendAlpha);
+
+    /**
+     * @brief Добавляет объект, который рисуется отдельно после прямоугольников слоя.
+     *
+     * Объект должен существовать до вызова draw.
+     *
+     * @param layer Слой отрисовки.
+     * @param drawable Объект для отрисовки.
+     */
+    void add(Layer layer, const sf::Drawable& drawable);
+
+    /**
+     * @brief Отрисовывает добавленное в слои с first по last включительно.
+     *
+     * Разные диапазоны слоев можно рисовать с разными видами цели
+     * (например, поле - камерой, а метки - в координатах экрана).
+     *
+     * @param target Цель отрисовки.
+     * @param first Первый слой.
+     * @param last Последний слой.
+     */
+    void draw(sf::RenderTarget& target, Layer first = Layer::Background, Layer last = Layer::Labels);
+
+    /**
+     * @brief Количество вызовов отрисовки с последнего clear.
+     * @return Количество вызовов отрисовки.
+     */
+    std::size_t get_draw_calls(void) const;
+
+    /**
+     * @brief Количество нарисованных прямоугольников с последнего clear.
+     * @return Количество прямоугольников.
+     */
+    std::size_t get_quad_count(void) const;
+
+    /**
+     * @brief Количество смен состояния (текстуры или режима смешивания) с последнего clear.
+     *
+     * Первый вызов отрисовки кадра тоже считается сменой состояния.
+     *
+     * @return Количество смен состояния.
+     */
+    std::size_t get_state_changes(void) const;
+
+    /**
+     * @brief Вызовы отрисовки с последнего clear в порядке выполнения.
+     * @return Список вызовов отрисовки.
+     */
+    const std::vector<DrawCall>& get_draw_list(void) const;
+
+    /**
+     * @brief Сохраняет ли слой порядок добавления прямоугольников.
+     * @param layer Слой.
+     * @return true, если прямоугольники слоя рисуются в порядке добавления,
+     * false, если они группируются по состояниям.
+     */
+    static bool keeps_order(Layer layer);
+
+    /**
+     * @brief Площадь прямоугольников последнего draw в пикселях.
+     *
+     * Считается по сохраненным вершинам, поэтому верна до следующего clear.
+     * Объекты, добавленные как sf::Drawable, не учитываются.
+     *
+     * @return Суммарная площадь прямоугольников.
+     */
+    std::size_t get_pixel_count(void) const;
+
+    /**
+     * @brief Записывает прямоугольник с текстурой как два треугольника.
+     * @param vertices Куда добавить вершины.
+     * @param rect Прямоугольник на экране.
+     * @param tex_rect Прямоугольник в текстуре (в пикселях).
+     * @param color Цвет, на который умножается текстура.
+     */
+    static void append_quad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, const sf::IntRect& tex_rect,
+                            const sf::Color& color = sf::Color::White);
+
+    /**
+     * @brief Записывает готовые вершины, сдвинутые на заданное смещение.
+     * @param dest Куда добавить вершины.
+     * @param vertices Вершины.
+     * @param count Количество вершин.
+     * @param offset Смещение, прибавляемое к позициям вершин.
+     */
+    static void append_vertices(std::vector<sf::Vertex>& dest, const sf::Vertex* vertices, std::size_t count,
+                                const sf::Vector2f& offset);
+
+    /**
+     * @brief Площадь прямоугольников, записанных append_quad.
+     * @param vertices Вершины (по шесть на прямоугольник).
+     * @param count Количество вершин.
+     * @return Суммарная площадь прямоугольников в пикселях.
+     */
+    static double get_quads_area(const sf::Vertex* vertices, std::size_t count);
+
+private:
+    /**
+     * @brief Прямоугольники с одинаковым состоянием внутри слоя.
+     */
+    struct Batch
+    {
+        const sf::Texture* texture = nullptr;        ///< Текстура пакета.
+        sf::BlendMode blend = sf::BlendAlpha;        ///< Режим смешивания пакета.
+        std::vector<sf::Vertex> vertices;            ///< Вершины (по два треугольника на прямоугольник).
+    };
+
+    /**
+     * @brief Содержимое одного слоя.
+     */
+    struct LayerData
+    {
+        std::vector<Batch> batches;                 ///< Пакеты по состояниям (в порядке первого использования).
+        std::vector<const sf::Drawable*> drawables; ///< Объекты, которые рисуются отдельно.
+        std::size_t used = 0;                       ///< Количество пакетов, начатых за кадр (для слоя с порядком добавления).
+    };
+
+    /**
+     * @brief Находит пакет состояния в слое или создает новый.
+     *
+     * В слое с порядком добавления продолжается только последний пакет.
+     *
+     * @param layer Слой.
+     * @param texture Текстура.
+     * @param blend Режим смешивания.
+     * @return Пакет состояния.
+     */
+    Batch& get_batch(Layer layer, const sf::Texture* texture, const sf::BlendMode& blend);
+
+    /**
+     * @brief Рисует пакет и учитывает смену состояния.
+     * @param target Цель отрисовки.
+     * @param layer Слой пакета.
+     * @param batch Пакет.
+     */
+    void submit(sf::RenderTarget& target, Layer layer, const Batch& batch);
+
+    static constexpr std::size_t mc_layer_count = 5; ///< Количество слоев.
+
+    std::array<LayerData, mc_layer_count> m_layers; ///< Слои отрисовки.
+    std::size_t m_draw_calls = 0; ///< Количество вызовов отрисовки с последнего clear.
+    std::size_t m_quads = 0; ///< Количество прямоугольников с последнего clear.
+    std::size_t m_state_changes = 0; ///< Количество смен состояния с последнего clear.
+    const sf::Texture* m_texture = nullptr; ///< Текстура последнего вызова отрисовки.
+    sf::BlendMode m_blend = sf::BlendAlpha; ///< Режим смешивания последнего вызова отрисовки.
+    bool m_has_state = false; ///< Известно ли состояние последнего вызова отрисовки.
+    std::vector<DrawCall> m_draw_list; ///< Вызовы отрисовки с последнего clear.
+};
+
+#endif // SPRITEBATCH_H
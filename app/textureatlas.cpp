@@ -0,0 +1,399 @@
+#include "textureatlas.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Микросекунды с заданного момента
+    std::int64_t elapsed_us(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+// Пул потоков для декодирования
+void TextureAtlas::set_thread_pool(ThreadPool* pool)
+{
+    m_pool = pool;
+}
+
+// Загрузка полосы кадров из файла
+bool TextureAtlas::add_strip(const std::string& path, std::size_t n, std::vector<AtlasFrame>& frames,
+                             Priority priority)
+{
+    // Полоса из пака уже разложена и загружена в видеопамять
+    if (add_packed_strip(path, n, frames))
+        return true;
+
+    ++m_decoded_count;
+    if (m_pool != nullptr)
+    {
+        // Картинка декодируется в пуле потоков, а кадры до build остаются пустыми
+        std::shared_ptr<Decode> decode = std::make_shared<Decode>();
+        decode->path = path;
+        std::future<void> decoded = decode->done.get_future();
+        m_pool->submit([decode]() {
+            auto start = std::chrono::steady_clock::now();
+            decode->success = decode->image.loadFromFile(decode->path);
+            decode->microseconds = elapsed_us(start);
+            decode->done.set_value();
+        });
+
+        frames.assign(n, AtlasFrame());
+        m_strips.push_back(Strip{sf::Image(), n, &frames, path, priority, std::move(decode), std::move(decoded)});
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    sf::Image image;
+    bool success = image.loadFromFile(path);
+    add_timing(path, elapsed_us(start), false);
+
+    add_strip(image, n, frames, path); // Даже без картинки нужны пустые кадры
+    m_strips.back().priority = priority;
+    return success;
+}
+
+// Добавление полосы кадров из картинки
+void TextureAtlas::add_strip(const sf::Image& image, std::size_t n, std::vector<AtlasFrame>& frames,
+                             const std::string& name)
+{
+    frames.assign(n, AtlasFrame()); // Анимации можно создавать до build
+    m_strips.push_back(Strip{image, n, &frames, name, Priority::FirstFrame, nullptr, std::future<void>()});
+}
+
+// Полоса кадров из пака
+bool TextureAtlas::add_packed_strip(const std::string& name, std::size_t n, std::vector<AtlasFrame>& frames)
+{
+    std::size_t count = 0;
+    const AssetPack::Frame* packed = m_pack.is_open() ? m_pack.find_strip(name, count) : nullptr;
+    if (packed == nullptr || count != n)
+        return false;
+
+    frames.assign(n, AtlasFrame());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // Кадр, не загруженный при сборке пака, остается пустым
+        if (packed[i].page < 0 || static_cast<std::size_t>(packed[i].page) >= m_pack.get_page_count())
+            continue;
+        frames[i].texture = m_pages[m_pack_first_page + static_cast<std::size_t>(packed[i].page)].get();
+        frames[i].rect = sf::IntRect(packed[i].left, packed[i].top, packed[i].width, packed[i].height);
+    }
+    return true;
+}
+
+// Добавление блока данных
+void TextureAtlas::add_data(const std::string& name, const void* bytes, std::size_t size)
+{
+    const char* begin = static_cast<const char*>(bytes);
+    m_data.push_back(AssetPack::Data{name, std::vector<char>(begin, begin + size)});
+}
+
+// Поиск блока данных в паке
+const char* TextureAtlas::find_data(const std::string& name, std::size_t& size) const
+{
+    return m_pack.is_open() ? m_pack.find_data(name, size) : nullptr;
+}
+
+// Готовность полос
+bool TextureAtlas::is_ready(Priority priority) const
+{
+    return get_pending_count(priority) == 0;
+}
+
+// Количество декодируемых полос
+std::size_t TextureAtlas::get_pending_count(Priority priority) const
+{
+    return static_cast<std::size_t>(std::count_if(m_strips.begin(), m_strips.end(), [priority](const Strip& strip) {
+        return strip.priority <= priority && strip.decode != nullptr &&
+                strip.decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }));
+}
+
+// Раскладка кадров и создание текстур
+bool TextureAtlas::build(Priority priority, unsigned page_size)
+{
+    // Полосы с меньшим приоритетом ждут следующего build
+    std::vector<Strip> strips;
+    std::vector<Strip> later;
+    for (Strip& strip : m_strips)
+        (strip.priority <= priority ? strips : later).push_back(std::move(strip));
+    m_strips = std::move(later);
+
+    bool success = true;
+    for (Strip& strip : strips)
+    {
+        if (!take_decoded(strip))
+            success = false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<sf::Image> images;
+    std::vector<Placement> placements;
+    if (!layout(strips, std::min(page_size, sf::Texture::getMaximumSize()), images, placements))
+        success = false;
+
+    // Новые страницы добавляются после уже созданных (в том числе загруженных из пака)
+    std::size_t first_page = m_pages.size();
+    for (const sf::Image& image : images)
+    {
+        m_pages.push_back(std::make_unique<sf::Texture>());
+        if (!m_pages.back()->loadFromImage(image))
+            success = false;
+    }
+
+    // Кадры записываются на место пустых, поэтому анимации, созданные до build, видят их сразу
+    for (const Placement& placement : placements)
+    {
+        AtlasFrame& frame = (*strips[placement.strip].frames)[placement.frame];
+        frame.texture = m_pages[first_page + placement.page].get();
+        frame.rect = placement.rect;
+    }
+    if (!images.empty())
+        add_timing("atlas: " + std::to_string(images.size()) + " pages", elapsed_us(start), false);
+
+    // Картинки полос и отображение пака больше не нужны
+    m_data.clear();
+    m_pack.close();
+    return success;
+}
+
+// Загрузка пака
+bool TextureAtlas::load_pack(const std::string& path)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (!m_pack.open(path))
+        return false;
+
+    // Страницы загружаются в видеопамять прямо из отображенного файла
+    std::vector<std::unique_ptr<sf::Texture>> pages;
+    for (std::size_t i = 0; i < m_pack.get_page_count(); ++i)
+    {
+        sf::Vector2u size = m_pack.get_page_size(i);
+        pages.push_back(std::make_unique<sf::Texture>());
+        if (size.x > sf::Texture::getMaximumSize() || size.y > sf::Texture::getMaximumSize() ||
+                !pages.back()->create(size.x, size.y))
+        {
+            m_pack.close();
+            return false;
+        }
+        pages.back()->update(m_pack.get_page_pixels(i));
+    }
+
+    m_pack_first_page = m_pages.size();
+    for (std::unique_ptr<sf::Texture>& page : pages)
+        m_pages.push_back(std::move(page));
+    add_timing(path, elapsed_us(start), false);
+    return true;
+}
+
+// Сохранение раскладки в пак
+bool TextureAtlas::save_pack(const std::string& path, unsigned page_size)
+{
+    bool success = true;
+    for (Strip& strip : m_strips)
+    {
+        if (!take_decoded(strip))
+            success = false;
+    }
+
+    std::vector<sf::Image> images;
+    std::vector<Placement> placements;
+    if (!layout(m_strips, page_size, images, placements))
+        success = false;
+
+    // Кадры, которые не удалось разложить, сохраняются пустыми
+    std::vector<AssetPack::Strip> strips;
+    std::vector<std::size_t> strip_index(m_strips.size(), static_cast<std::size_t>(-1));
+    for (std::size_t s = 0; s < m_strips.size(); ++s)
+    {
+        if (m_strips[s].name.empty())
+            continue;
+        strip_index[s] = strips.size();
+        strips.push_back(AssetPack::Strip{m_strips[s].name, std::vector<AssetPack::Frame>(m_strips[s].n, AssetPack::Frame{-1, 0, 0, 0, 0})});
+    }
+
+    for (const Placement& placement : placements)
+    {
+        std::size_t s = strip_index[placement.strip];
+        if (s < strips.size())
+            strips[s].frames[placement.frame] = AssetPack::Frame{static_cast<int32_t>(placement.page), placement.rect.left,
+                                                                 placement.rect.top, placement.rect.width, placement.rect.height};
+    }
+
+    if (!AssetPack::write(path, images, strips, m_data))
+        success = false;
+
+    m_strips.clear();
+    m_data.clear();
+    return success;
+}
+
+// Количество прочитанных картинок
+std::size_t TextureAtlas::get_decoded_count(void) const
+{
+    return m_decoded_count;
+}
+
+// Запись длительности загрузки
+void TextureAtlas::add_timing(const std::string& name, std::int64_t microseconds, bool is_async)
+{
+    m_timings.push_back(LoadTiming{name, microseconds, is_async});
+}
+
+// Длительности загрузки
+const std::vector<TextureAtlas::LoadTiming>& TextureAtlas::get_timings(void) const
+{
+    return m_timings;
+}
+
+// Картинка, декодированная в пуле потоков
+bool TextureAtlas::take_decoded(Strip& strip)
+{
+    if (strip.decode == nullptr)
+        return true;
+
+    strip.decoded.wait();
+    strip.image = std::move(strip.decode->image);
+    add_timing(strip.name, strip.decode->microseconds, true);
+    bool success = strip.decode->success;
+    strip.decode.reset();
+    return success;
+}
+
+// Раскладка кадров по страницам
+bool TextureAtlas::layout(const std::vector<Strip>& strips, unsigned page_size, std::vector<sf::Image>& images,
+                          std::vector<Placement>& placements)
+{
+    /**
+     * @brief Кадр, который нужно положить на страницу.
+     */
+    struct Item
+    {
+        std::size_t strip;   ///< Номер полосы.
+        std::size_t frame;   ///< Номер кадра в полосе.
+        sf::IntRect source;  ///< Прямоугольник кадра в картинке полосы.
+        std::size_t page;    ///< Страница, на которую положен кадр.
+        sf::Vector2u pos;    ///< Позиция кадра на странице.
+    };
+
+    /**
+     * @brief Полка страницы: ряд кадров не выше полки.
+     */
+    struct Shelf
+    {
+        unsigned y;       ///< Верх полки.
+        unsigned height;  ///< Высота полки.
+        unsigned width;   ///< Занятая ширина.
+    };
+
+    /**
+     * @brief Страница при раскладке.
+     */
+    struct Page
+    {
+        std::vector<Shelf> shelves; ///< Полки страницы.
+        unsigned width = 0;         ///< Занятая ширина.
+        unsigned height = 0;        ///< Занятая высота.
+    };
+
+    bool success = true;
+    std::vector<Item> items;
+    for (std::size_t s = 0; s < strips.size(); ++s)
+    {
+        const Strip& strip = strips[s];
+        sf::Vector2u size = strip.image.getSize();
+        if (strip.n == 0 || size.x < strip.n || size.y == 0) // Картинка не загрузилась
+            continue;
+
+        int frame_width = static_cast<int>(size.x / strip.n);
+        for (std::size_t i = 0; i < strip.n; ++i)
+            items.push_back(Item{s, i, sf::IntRect(static_cast<int>(i) * frame_width, 0, frame_width, static_cast<int>(size.y)), 0, sf::Vector2u()});
+    }
+
+    // Высокие кадры первыми: полки получаются плотнее
+    std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.source.height > b.source.height;
+    });
+
+    std::vector<Page> pages;
+    for (Item& item : items)
+    {
+        unsigned width = static_cast<unsigned>(item.source.width) + mc_padding;
+        unsigned height = static_cast<unsigned>(item.source.height) + mc_padding;
+        if (width > page_size || height > page_size)
+        {
+            success = false;
+            item.page = static_cast<std::size_t>(-1);
+            continue;
+        }
+
+        // Сначала самая низкая из подходящих полок на всех страницах
+        Page* best_page = nullptr;
+        Shelf* best_shelf = nullptr;
+        for (std::size_t p = 0; p < pages.size(); ++p)
+        {
+            for (Shelf& shelf : pages[p].shelves)
+            {
+                if (shelf.width + width <= page_size && height <= shelf.height &&
+                        (best_shelf == nullptr || shelf.height < best_shelf->height))
+                {
+                    best_page = &pages[p];
+                    best_shelf = &shelf;
+                    item.page = p;
+                }
+            }
+        }
+
+        // Затем новая полка на первой странице, где хватает высоты, или новая страница
+        if (best_shelf == nullptr)
+        {
+            std::size_t p = 0;
+            while (p < pages.size() && pages[p].height + height > page_size)
+                ++p;
+            if (p == pages.size())
+                pages.emplace_back();
+
+            best_page = &pages[p];
+            best_page->shelves.push_back(Shelf{best_page->height, height, 0});
+            best_page->height += height;
+            best_shelf = &best_page->shelves.back();
+            item.page = p;
+        }
+
+        item.pos = sf::Vector2u(best_shelf->width, best_shelf->y);
+        best_shelf->width += width;
+        best_page->width = std::max(best_page->width, best_shelf->width);
+    }
+
+    // Копируем кадры в картинки страниц
+    images.assign(pages.size(), sf::Image());
+    for (std::size_t p = 0; p < pages.size(); ++p)
+        images[p].create(pages[p].width, pages[p].height, sf::Color::Transparent);
+
+    placements.clear();
+    for (const Item& item : items)
+    {
+        if (item.page >= pages.size())
+            continue;
+
+        images[item.page].copy(strips[item.strip].image, item.pos.x, item.pos.y, item.source);
+        placements.push_back(Placement{item.strip, item.frame, item.page,
+                                       sf::IntRect(static_cast<int>(item.pos.x), static_cast<int>(item.pos.y),
+                                                   item.source.width, item.source.height)});
+    }
+    return success;
+}
+
+// Количество страниц
+std::size_t TextureAtlas::get_page_count(void) const
+{
+    return m_pages.size();
+}
+
+// Страница атласа
+const sf::Texture& TextureAtlas::get_page(std::size_t index) const
+{
+    return *m_pages[index];
+}
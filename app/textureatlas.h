@@ -0,0 +1,292 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "assetpack.h"
+#include "threadpool.h"
+
+/**
+ * @brief Кадр анимации внутри атласа.
+ */
+struct AtlasFrame
+{
+    const sf::Texture* texture = nullptr; ///< Страница атласа (nullptr - кадр не загружен).
+    sf::IntRect rect;                     ///< Прямоугольник кадра на странице.
+};
+
+/**
+ * @brief Атлас текстур: все кадры всех полос анимаций на нескольких больших текстурах.
+ *
+ * Полосы кадров (картинки, в которых кадры идут слева направо) добавляются
+ * при загрузке ресурсов, затем build раскладывает все кадры по страницам
+ * полками (кадры сортируются по высоте и ставятся рядами) и создает по одной
+ * текстуре на страницу. Кадры разных объектов оказываются на одной текстуре,
+ * поэтому смешанное поле рисуется без переключения текстур.
+ *
+ * Готовую раскладку можно заранее сохранить в пак (save_pack). Если перед
+ * добавлением полос открыть пак (load_pack), его страницы загружаются в
+ * видеопамять из отображенного файла, а полосы, которые есть в паке,
+ * получают кадры сразу, без чтения и декодирования картинок.
+ *
+ * С пулом потоков (set_thread_pool) картинки декодируются параллельно, а
+ * add_strip сразу возвращается. Текстуры создаются только в build, в потоке
+ * OpenGL. Полосы с приоритетом Deferred не задерживают первый кадр игры: их
+ * можно разложить отдельным вызовом build, когда is_ready сообщит, что они
+ * декодированы. До этого их кадры пустые (без текстуры).
+ */
+class TextureAtlas
+{
+public:
+    /**
+     * @brief Когда полоса кадров нужна игре.
+     */
+    enum class Priority
+    {
+        FirstFrame, ///< Нужна уже для первого кадра игры.
+        Deferred    ///< Нужна позже (например, эффекты, которые показываются по событиям матча).
+    };
+
+    /**
+     * @brief Длительность загрузки одного ресурса.
+     */
+    struct LoadTiming
+    {
+        std::string name;          ///< Ресурс (путь к картинке, шрифт или страницы атласа).
+        std::int64_t microseconds; ///< Длительность в микросекундах.
+        bool is_async;             ///< Выполнялась в пуле потоков (иначе в потоке OpenGL).
+    };
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit TextureAtlas(void) = default;
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /**
+     * @brief Задает пул потоков для декодирования картинок.
+     * @param pool Пул потоков (должен существовать до build; nullptr - декодировать сразу в add_strip).
+     */
+    void set_thread_pool(ThreadPool* pool);
+
+    /**
+     * @brief Загружает полосу кадров из файла.
+     *
+     * Если полоса с таким путем есть в открытом паке, кадры записываются в
+     * frames сразу, а файл не читается. Иначе в frames сразу записываются n
+     * пустых кадров, а настоящие будут записаны на их место при вызове
+     * build. Если файл не загрузился, кадры так и остаются пустыми, чтобы
+     * анимации создавались.
+     *
+     * @param path Путь к картинке (он же имя полосы в паке).
+     * @param n Количество кадров в полосе.
+     * @param frames Куда записать кадры (должен существовать до вызова build).
+     * @param priority Когда полоса нужна игре.
+     * @return True, если картинка загружена или отдана на декодирование в пул потоков (ошибку
+     *         декодирования в пуле сообщит build), false в противном случае.
+     */
+    bool add_strip(const std::string& path, std::size_t n, std::vector<AtlasFrame>& frames,
+                   Priority priority = Priority::FirstFrame);
+
+    /**
+     * @brief Добавляет полосу кадров из готовой картинки.
+     * @param image Картинка с кадрами слева направо.
+     * @param n Количество кадров в полосе.
+     * @param frames Куда записать кадры (должен существовать до вызова build).
+     * @param name Имя полосы в паке (пустое - полоса в пак не попадает).
+     */
+    void add_strip(const sf::Image& image, std::size_t n, std::vector<AtlasFrame>& frames,
+                   const std::string& name = std::string());
+
+    /**
+     * @brief Берет полосу кадров из открытого пака.
+     * @param name Имя полосы.
+     * @param n Количество кадров в полосе.
+     * @param frames Куда записать кадры.
+     * @return true, если полоса из n кадров есть в паке, иначе false (frames не меняется).
+     */
+    bool add_packed_strip(const std::string& name, std::size_t n, std::vector<AtlasFrame>& frames);
+
+    /**
+     * @brief Добавляет именованный блок данных, который save_pack сохранит в пак.
+     * @param name Имя блока.
+     * @param bytes Содержимое блока.
+     * @param size Размер блока в байтах.
+     */
+    void add_data(const std::string& name, const void* bytes, std::size_t size);
+
+    /**
+     * @brief Находит блок данных в открытом паке.
+     * @param name Имя блока.
+     * @param size Куда записать размер блока.
+     * @return Содержимое блока (действительно до build) или nullptr, если блока нет.
+     */
+    const char* find_data(const std::string& name, std::size_t& size) const;
+
+    /**
+     * @brief Проверяет, декодированы ли полосы, не дожидаясь их.
+     * @param priority Проверяются полосы с этим и более высоким приоритетом.
+     * @return true, если build с этим приоритетом не будет ждать пул потоков, иначе false.
+     */
+    bool is_ready(Priority priority) const;
+
+    /**
+     * @brief Количество полос, которые еще декодируются в пуле потоков.
+     * @param priority Считаются полосы с этим и более высоким приоритетом.
+     * @return Количество полос.
+     */
+    std::size_t get_pending_count(Priority priority) const;
+
+    /**
+     * @brief Раскладывает добавленные кадры по страницам и создает текстуры.
+     *
+     * Раскладываются полосы с заданным и более высоким приоритетом,
+     * добавленные после предыдущего вызова, на новые страницы. Если они
+     * еще декодируются в пуле потоков, build их дожидается. Открытый пак
+     * после этого закрывается. Вызывается в потоке OpenGL.
+     *
+     * @param priority Наименьший приоритет раскладываемых полос.
+     * @param page_size Наибольшая сторона страницы (ограничивается возможностями видеокарты).
+     * @return True, если все кадры загружены и разложены, false, если картинка не загрузилась
+     *         или кадр больше страницы.
+     */
+    bool build(Priority priority = Priority::Deferred, unsigned page_size = 4096);
+
+    /**
+     * @brief Открывает пак и загружает его страницы в видеопамять.
+     *
+     * Вызывается до добавления полос. Пак остается открытым до build.
+     *
+     * @param path Путь к файлу пака.
+     * @return true, если пак открыт и все страницы загружены, иначе false (атлас не меняется).
+     */
+    bool load_pack(const std::string& path);
+
+    /**
+     * @brief Раскладывает добавленные кадры и сохраняет раскладку в пак вместо создания текстур.
+     *
+     * В пак попадают страницы, именованные полосы и блоки данных. Видеокарта
+     * не нужна, поэтому полосы после сохранения удаляются, а кадры в frames
+     * не записываются.
+     *
+     * @param path Путь к файлу пака.
+     * @param page_size Наибольшая сторона страницы (не больше, чем у видеокарт, где будет запускаться игра).
+     * @return true, если все кадры разложены и файл записан, иначе false.
+     */
+    bool save_pack(const std::string& path, unsigned page_size = 4096);
+
+    /**
+     * @brief Количество картинок, прочитанных из файлов (а не взятых из пака).
+     * @return Количество прочитанных картинок.
+     */
+    std::size_t get_decoded_count(void) const;
+
+    /**
+     * @brief Записывает длительность загрузки ресурса (например, растеризации шрифта).
+     * @param name Ресурс.
+     * @param microseconds Длительность в микросекундах.
+     * @param is_async Выполнялась ли загрузка в пуле потоков.
+     */
+    void add_timing(const std::string& name, std::int64_t microseconds, bool is_async);
+
+    /**
+     * @brief Длительности загрузки ресурсов в порядке их окончания.
+     *
+     * Декодирование в пуле потоков записывается, когда build забирает картинку.
+     *
+     * @return Длительности загрузки.
+     */
+    const std::vector<LoadTiming>& get_timings(void) const;
+
+    /**
+     * @brief Количество страниц (текстур) атласа.
+     * @return Количество страниц.
+     */
+    std::size_t get_page_count(void) const;
+
+    /**
+     * @brief Страница атласа.
+     * @param index Номер страницы.
+     * @return Текстура страницы.
+     */
+    const sf::Texture& get_page(std::size_t index) const;
+
+private:
+    /**
+     * @brief Картинка, декодируемая в пуле потоков.
+     *
+     * Принадлежит и полосе, и задаче пула, поэтому атлас может быть
+     * разрушен раньше, чем задача закончится.
+     */
+    struct Decode
+    {
+        std::string path;               ///< Путь к картинке.
+        sf::Image image;                ///< Декодированная картинка.
+        bool success = false;           ///< Загрузилась ли картинка.
+        std::int64_t microseconds = 0;  ///< Время чтения и декодирования.
+        std::promise<void> done;        ///< Сигнал окончания декодирования.
+    };
+
+    /**
+     * @brief Добавленная, но еще не разложенная полоса кадров.
+     */
+    struct Strip
+    {
+        sf::Image image;                  ///< Картинка полосы (пустая, если не загрузилась).
+        std::size_t n = 0;                ///< Количество кадров.
+        std::vector<AtlasFrame>* frames;  ///< Куда записать кадры.
+        std::string name;                 ///< Имя полосы в паке.
+        Priority priority = Priority::FirstFrame; ///< Когда полоса нужна игре.
+        std::shared_ptr<Decode> decode;           ///< Декодирование в пуле потоков (nullptr - картинка уже в image).
+        std::future<void> decoded;                ///< Готовность декодирования в пуле потоков.
+    };
+
+    /**
+     * @brief Положение кадра после раскладки.
+     */
+    struct Placement
+    {
+        std::size_t strip;  ///< Номер полосы.
+        std::size_t frame;  ///< Номер кадра в полосе.
+        std::size_t page;   ///< Номер страницы.
+        sf::IntRect rect;   ///< Прямоугольник кадра на странице.
+    };
+
+    /**
+     * @brief Раскладывает кадры полос по страницам.
+     * @param strips Полосы.
+     * @param page_size Наибольшая сторона страницы.
+     * @param images Куда записать картинки страниц.
+     * @param placements Куда записать положения разложенных кадров (номера полос - в strips).
+     * @return True, если все кадры разложены, false, если кадр больше страницы.
+     */
+    static bool layout(const std::vector<Strip>& strips, unsigned page_size, std::vector<sf::Image>& images,
+                       std::vector<Placement>& placements);
+
+    /**
+     * @brief Дожидается декодирования картинки полосы в пуле потоков и забирает ее.
+     * @param strip Полоса.
+     * @return true, если картинка загружена (или декодировалась не в пуле), иначе false.
+     */
+    bool take_decoded(Strip& strip);
+
+    static constexpr unsigned mc_padding = 2; ///< Прозрачный зазор между кадрами (от просачивания соседей при сглаживании).
+
+    std::vector<Strip> m_strips; ///< Полосы, ожидающие раскладки.
+    std::vector<std::unique_ptr<sf::Texture>> m_pages; ///< Страницы атласа.
+    std::vector<AssetPack::Data> m_data; ///< Блоки данных для сохранения в пак.
+    AssetPack m_pack; ///< Открытый пак.
+    std::size_t m_pack_first_page = 0; ///< Номер первой страницы атласа, загруженной из пака.
+    std::size_t m_decoded_count = 0; ///< Количество картинок, прочитанных из файлов.
+    ThreadPool* m_pool = nullptr; ///< Пул потоков для декодирования (nullptr - декодировать сразу).
+    std::vector<LoadTiming> m_timings; ///< Длительности загрузки ресурсов.
+};
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,161 @@
+#include "vertexstream.h"
+
+#include <algorithm>
+
+#include "spritebatch.h"
+
+namespace
+{
+    // Сравнение вершин (у sf::Vertex нет оператора сравнения)
+    bool is_same_vertex(const sf::Vertex& a, const sf::Vertex& b)
+    {
+        return a.position == b.position && a.color == b.color && a.texCoords == b.texCoords;
+    }
+}
+
+// Конструктор класса VertexStream
+VertexStream::VertexStream(std::size_t slot_size)
+    : m_slot_size(slot_size),
+      m_buffer(sf::Triangles, sf::VertexBuffer::Stream)
+{
+}
+
+// Поддержка буферов вершин
+bool VertexStream::is_available(void)
+{
+    return sf::VertexBuffer::isAvailable();
+}
+
+// Начало нового кадра
+void VertexStream::begin(void)
+{
+    std::fill(m_written.begin(), m_written.end(), 0);
+    m_ranges.clear();
+    m_written_slots = 0;
+    m_uploaded_bytes = 0;
+}
+
+// Запись вершин объекта
+void VertexStream::write(std::size_t slot, const sf::Vertex* vertices, std::size_t count)
+{
+    std::size_t slot_count = m_written.size();
+    if (slot >= slot_count)
+    {
+        // Новые слоты заполнены вырожденными вершинами и помечены измененными: если видеопамять
+        // уже выросла с запасом, пропущенные слоты иначе рисовались бы из неинициализированной памяти
+        m_vertices.resize((slot + 1) * m_slot_size);
+        m_written.resize(slot + 1, 0);
+        m_dirty.resize(slot + 1, 1);
+    }
+
+    if (!m_written[slot])
+        ++m_written_slots;
+    m_written[slot] = 1;
+
+    // Сравниваем с прежним содержимым слота, чтобы не загружать неизменившиеся вершины
+    sf::Vertex* dest = &m_vertices[slot * m_slot_size];
+    count = std::min(count, m_slot_size);
+    bool changed = false;
+    for (std::size_t i = 0; i < m_slot_size; ++i)
+    {
+        sf::Vertex vertex = i < count ? vertices[i] : sf::Vertex();
+        if (!is_same_vertex(dest[i], vertex))
+        {
+            dest[i] = vertex;
+            changed = true;
+        }
+    }
+    if (changed)
+        m_dirty[slot] = 1;
+}
+
+// Завершение кадра
+void VertexStream::finish(void)
+{
+    // Незаписанные слоты (удаленные или невидимые объекты) становятся вырожденными
+    std::size_t written_slots = m_written_slots;
+    for (std::size_t slot = 0; slot < m_written.size(); ++slot)
+    {
+        if (!m_written[slot])
+        {
+            write(slot, nullptr, 0);
+            m_written[slot] = 0;
+        }
+    }
+    m_written_slots = written_slots;
+
+    // Соседние измененные слоты объединяем в один диапазон, чтобы уменьшить число загрузок
+    m_ranges.clear();
+    std::size_t run_begin = 0;
+    std::size_t run_end = 0; // Пустой диапазон
+    for (std::size_t slot = 0; slot < m_dirty.size(); ++slot)
+    {
+        if (!m_dirty[slot])
+            continue;
+
+        if (run_end > run_begin && slot - run_end <= mc_merge_gap)
+        {
+            run_end = slot + 1;
+            continue;
+        }
+        if (run_end > run_begin)
+            m_ranges.emplace_back(run_begin * m_slot_size, (run_end - run_begin) * m_slot_size);
+        run_begin = slot;
+        run_end = slot + 1;
+    }
+    if (run_end > run_begin)
+        m_ranges.emplace_back(run_begin * m_slot_size, (run_end - run_begin) * m_slot_size);
+
+    // Изменения переходят в диапазоны и будут загружены в draw
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+}
+
+// Измененные диапазоны
+const std::vector<std::pair<std::size_t, std::size_t>>& VertexStream::get_dirty_ranges(void) const
+{
+    return m_ranges;
+}
+
+// Загрузка изменений и отрисовка
+void VertexStream::draw(sf::RenderTarget& target, const sf::Texture& texture)
+{
+    if (m_vertices.empty())
+        return;
+
+    if (m_buffer.getVertexCount() < m_vertices.size())
+    {
+        // Буфер растет с запасом и загружается целиком
+        m_buffer.create(std::max(m_vertices.size(), m_buffer.getVertexCount() * 2));
+        m_buffer.update(m_vertices.data(), m_vertices.size(), 0);
+        m_uploaded_bytes += m_vertices.size() * sizeof(sf::Vertex);
+    }
+    else
+    {
+        for (const std::pair<std::size_t, std::size_t>& range : m_ranges)
+        {
+            m_buffer.update(&m_vertices[range.first], range.second, static_cast<unsigned>(range.first));
+            m_uploaded_bytes += range.second * sizeof(sf::Vertex);
+        }
+    }
+    m_ranges.clear();
+
+    target.draw(m_buffer, 0, m_vertices.size(), sf::RenderStates(&texture));
+}
+
+// Загруженные байты
+std::size_t VertexStream::get_uploaded_bytes(void) const
+{
+    return m_uploaded_bytes;
+}
+
+// Количество записанных слотов
+std::size_t VertexStream::get_written_slots(void) const
+{
+    return m_written_slots;
+}
+
+// Площадь прямоугольников
+std::size_t VertexStream::get_pixel_count(void) const
+{
+    return static_cast<std::size_t>(SpriteBatch::get_quads_area(m_vertices.data(), m_vertices.size()));
+}
@@ -0,0 +1,106 @@
+#ifndef VERTEXSTREAM_H
+#define VERTEXSTREAM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Постоянный буфер вершин в видеопамяти с частичной загрузкой.
+ *
+ * Буфер разбит на слоты одинакового размера: у каждого объекта свой слот,
+ * номер которого не меняется, пока объект жив (например, слот EntityStore).
+ * За кадр в слоты записываются вершины видимых объектов, и копия буфера в
+ * памяти сравнивается с новыми вершинами - в видеопамять (sf::VertexBuffer
+ * с режимом Stream) загружаются только изменившиеся диапазоны. Слоты, в
+ * которые за кадр ничего не записали, заполняются вырожденными вершинами.
+ *
+ * Кадр: begin, write для каждого видимого объекта, finish, draw. Копия
+ * в памяти считается загруженной после finish, поэтому draw должен
+ * вызываться после каждого finish.
+ *
+ * Весь буфер рисуется одним вызовом с одной текстурой.
+ */
+class VertexStream
+{
+public:
+    /**
+     * @brief Конструктор.
+     * @param slot_size Количество вершин в слоте (кратно шести - по два треугольника на прямоугольник).
+     */
+    explicit VertexStream(std::size_t slot_size);
+
+    /**
+     * @brief Проверяет, поддерживает ли видеокарта буферы вершин.
+     * @return true, если sf::VertexBuffer доступен, иначе false.
+     */
+    static bool is_available(void);
+
+    /**
+     * @brief Начинает новый кадр: все слоты считаются незаписанными.
+     */
+    void begin(void);
+
+    /**
+     * @brief Записывает вершины объекта в его слот.
+     *
+     * Лишние вершины отбрасываются, недостающие заполняются вырожденными.
+     * Слот помечается измененным, только если вершины отличаются от прежних.
+     *
+     * @param slot Номер слота.
+     * @param vertices Вершины объекта.
+     * @param count Количество вершин.
+     */
+    void write(std::size_t slot, const sf::Vertex* vertices, std::size_t count);
+
+    /**
+     * @brief Завершает кадр: очищает незаписанные слоты и собирает измененные диапазоны.
+     */
+    void finish(void);
+
+    /**
+     * @brief Измененные диапазоны вершин, собранные в finish и еще не загруженные.
+     * @return Пары (первая вершина, количество вершин).
+     */
+    const std::vector<std::pair<std::size_t, std::size_t>>& get_dirty_ranges(void) const;
+
+    /**
+     * @brief Загружает измененные диапазоны в видеопамять и рисует буфер.
+     * @param target Цель отрисовки.
+     * @param texture Текстура всех прямоугольников буфера.
+     */
+    void draw(sf::RenderTarget& target, const sf::Texture& texture);
+
+    /**
+     * @brief Количество байт, загруженных в видеопамять с последнего begin.
+     * @return Количество байт.
+     */
+    std::size_t get_uploaded_bytes(void) const;
+
+    /**
+     * @brief Количество записанных за кадр слотов.
+     * @return Количество слотов.
+     */
+    std::size_t get_written_slots(void) const;
+
+    /**
+     * @brief Площадь прямоугольников буфера в пикселях.
+     * @return Суммарная площадь прямоугольников.
+     */
+    std::size_t get_pixel_count(void) const;
+
+private:
+    static constexpr std::size_t mc_merge_gap = 4; ///< Наибольший промежуток (в слотах) между объединяемыми диапазонами.
+
+    std::size_t m_slot_size; ///< Количество вершин в слоте.
+    std::vector<sf::Vertex> m_vertices; ///< Копия содержимого видеопамяти.
+    std::vector<std::uint8_t> m_written; ///< Записан ли слот в текущем кадре.
+    std::vector<std::uint8_t> m_dirty; ///< Изменился ли слот в текущем кадре.
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges; ///< Измененные диапазоны вершин.
+    std::size_t m_written_slots = 0; ///< Количество записанных за кадр слотов.
+    std::size_t m_uploaded_bytes = 0; ///< Количество загруженных с последнего begin байт.
+    sf::VertexBuffer m_buffer; ///< Буфер в видеопамяти.
+};
+
+#endif // VERTEXSTREAM_H
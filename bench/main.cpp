@@ -0,0 +1,411 @@
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "alloccounter.h"
+#include "gamerenderer.h"
+#include "kinematics.h"
+
+namespace
+{
+    /**
+     * @brief Статистика времени кадра в микросекундах.
+     */
+    struct FrameStats
+    {
+        double mean = 0.0; ///< Среднее время.
+        double p50 = 0.0;  ///< Медиана.
+        double p99 = 0.0;  ///< 99-й перцентиль.
+        double max = 0.0;  ///< Максимальное время.
+    };
+
+    /**
+     * @brief Вычисляет статистику по замерам времени кадра.
+     * @param samples Замеры в микросекундах (будут отсортированы).
+     * @return Статистика замеров.
+     */
+    FrameStats calc_stats(std::vector<double>& samples)
+    {
+        FrameStats stats;
+        if (samples.empty())
+            return stats;
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+
+        stats.mean = sum / samples.size();
+        stats.p50 = samples[samples.size() / 2];
+        stats.p99 = samples[samples.size() * 99 / 100];
+        stats.max = samples.back();
+        return stats;
+    }
+
+    /**
+     * @brief Замеряет время GameRenderer::update для заданного способа обновления.
+     *
+     * Время в игре идет синтетически с шагом step миллисекунд, поэтому при
+     * маленьком шаге объекты дольше падают и на поле их накапливаются тысячи.
+     *
+     * @param mode Способ обновления объектов.
+     * @param name Название способа для отчета.
+     * @param step Шаг игрового времени за кадр в миллисекундах.
+     * @param warmup_frames Количество кадров до начала замеров.
+     * @param frames Количество замеряемых кадров.
+     * @return Количество выделений памяти за замеряемые кадры.
+     */
+    std::size_t run_update_bench(GameRenderer::UpdateMode mode, const std::string& name, int32_t step,
+                                 std::size_t warmup_frames, std::size_t frames)
+    {
+        sf::FloatRect game_board(0, 0, 402, 712);
+        GameRenderer game_renderer(game_board);
+        game_renderer.set_update_mode(mode);
+        game_renderer.set_spawn_chances(1000, 0, 1000); // Без льда, чтобы игра не замораживалась
+
+        int32_t cur_time = 0;
+        for (std::size_t i = 0; i < warmup_frames; ++i, cur_time += step)
+            game_renderer.update(cur_time);
+
+        std::vector<double> samples;
+        samples.reserve(frames);
+        std::size_t objects = 0;
+        std::size_t alloc_start = AllocCounter::get_count();
+        for (std::size_t i = 0; i < frames; ++i, cur_time += step)
+        {
+            auto start = std::chrono::steady_clock::now();
+            game_renderer.update(cur_time);
+            auto end = std::chrono::steady_clock::now();
+
+            samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            objects += game_renderer.get_objects_count();
+        }
+        std::size_t allocations = AllocCounter::get_count() - alloc_start;
+
+        FrameStats stats = calc_stats(samples);
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+                  << " objects " << std::setw(7) << objects / frames
+                  << "  mean " << std::setw(9) << stats.mean
+                  << "  p50 " << std::setw(9) << stats.p50
+                  << "  p99 " << std::setw(9) << stats.p99
+                  << "  max " << std::setw(9) << stats.max << " us"
+                  << "  allocs " << allocations << std::endl;
+        return allocations;
+    }
+
+    /**
+     * @brief Нажимает на первый еще не нажатый объект заданного типа.
+     * @param game_renderer Игра.
+     * @param kind Тип объекта.
+     * @return True, если такой объект нашелся, false в противном случае.
+     */
+    bool click_first(GameRenderer& game_renderer, EntityKind kind)
+    {
+        const EntityStore& entities = game_renderer.get_entities();
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            if (entities.get_kind(i) != kind || entities.is_activated(i))
+                continue;
+
+            sf::FloatRect rect = entities.get_rect(i);
+            game_renderer.click(sf::Vector2f(rect.left + rect.width / 2.f, rect.top + rect.height / 2.f));
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Замеряет время GameRenderer::draw в текстуру вне экрана.
+     *
+     * Поле заполняется обновлениями с шагом 1 мс, пока на нем не окажется
+     * population объектов (для больших полей - по несколько обновлений на
+     * миллисекунду, иначе объекты уходят с поля быстрее, чем появляются),
+     * после чего симуляция останавливается и идет только время анимаций. Заморозка и взрыв перезапускаются нажатием на лед и
+     * бомбу каждые mc_overlay_period мс, поэтому их анимации видны все время.
+     *
+     * Если поле больше текстуры, камера показывает его левый верхний угол,
+     * а остальные объекты отсекаются.
+     *
+     * @param target Текстура, в которую идет отрисовка.
+     * @param name Название сценария для отчета.
+     * @param mode Способ отрисовки объектов.
+     * @param game_board Игровое поле.
+     * @param population Количество объектов на поле.
+     * @param warmup_frames Количество кадров до начала замеров.
+     * @param frames Количество замеряемых кадров.
+     *
+     * Симуляция в этом замере стоит, поэтому нажатые объекты и всплывающие
+     * числа не возвращаются в пулы, и выделения памяти выводятся только для
+     * сведения (установившийся режим проверяет run_game_bench).
+     */
+    void run_render_bench(sf::RenderTexture& target, const std::string& name, GameRenderer::RenderMode mode,
+                                 const sf::FloatRect& game_board, std::size_t population, std::size_t warmup_frames,
+                                 std::size_t frames)
+    {
+        constexpr int32_t frame_time = 16;       // Время кадра при 60 FPS
+        constexpr int32_t overlay_period = 480;  // Меньше длительности анимаций заморозки и взрыва
+        constexpr std::size_t max_fill_updates = 200000;
+
+        sf::Vector2u target_size = target.getSize();
+        sf::FloatRect screen(0, 0, target_size.x, target_size.y);
+        GameRenderer game_renderer(game_board, screen);
+        game_renderer.set_spawn_chances(1000, 200, 200);
+        game_renderer.set_click_policy(GameRenderer::ClickPolicy::AllOverlapping);
+        if (!game_renderer.set_render_mode(mode))
+        {
+            std::cout << std::left << std::setw(10) << name << " not supported (no vertex buffers)" << std::endl;
+            return;
+        }
+
+        // Заполняем поле (без нажатий, поэтому без заморозки)
+        int32_t cur_time = 0;
+        std::size_t updates_per_ms = population / 4000 + 1;
+        for (std::size_t i = 0; i < max_fill_updates && game_renderer.get_objects_count() < population; ++i)
+        {
+            game_renderer.update(cur_time);
+            if ((i + 1) % updates_per_ms == 0)
+                ++cur_time;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(frames);
+        std::size_t draw_calls = 0;
+        std::size_t state_changes = 0;
+        std::size_t pixels = 0;
+        std::size_t uploaded = 0;
+        std::size_t visible = 0;
+        std::size_t allocations = 0;
+        for (std::size_t i = 0; i < warmup_frames + frames; ++i, cur_time += frame_time)
+        {
+            if (i % (overlay_period / frame_time) == 0)
+            {
+                click_first(game_renderer, EntityKind::Ice);
+                click_first(game_renderer, EntityKind::Bomb);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            target.clear();
+            game_renderer.draw(target, cur_time);
+            target.display();
+            auto end = std::chrono::steady_clock::now();
+
+            if (i < warmup_frames)
+                continue;
+            samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            draw_calls += game_renderer.get_draw_calls();
+            state_changes += game_renderer.get_state_changes();
+            pixels += game_renderer.get_pixel_count();
+            uploaded += game_renderer.get_uploaded_bytes();
+            visible += game_renderer.get_visible_objects();
+            allocations += game_renderer.get_frame_allocations();
+        }
+
+        FrameStats stats = calc_stats(samples);
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+                  << " objects " << std::setw(7) << game_renderer.get_objects_count()
+                  << "  visible " << std::setw(7) << visible / frames
+                  << "  mean " << std::setw(9) << stats.mean
+                  << "  p50 " << std::setw(9) << stats.p50
+                  << "  p99 " << std::setw(9) << stats.p99
+                  << "  max " << std::setw(9) << stats.max << " us"
+                  << "  draw calls " << std::setw(3) << draw_calls / frames
+                  << "  state changes " << std::setw(3) << state_changes / frames
+                  << "  pixels " << std::setw(9) << pixels / frames
+                  << "  uploaded " << std::setw(7) << uploaded / frames / 1024 << " KB"
+                  << "  allocs " << allocations << std::endl;
+    }
+
+    /**
+     * @brief Замеряет кадры игры так же, как их выполняет главный цикл приложения.
+     *
+     * Каждый кадр (16 мс) выполняет накопившиеся шаги симуляции по 10 мс и
+     * отрисовку, а лед и бомба нажимаются каждые 480 мс. Объекты и числа
+     * появляются и исчезают, поэтому после прогрева пулы выходят на
+     * установившийся размер, и выделений памяти за кадр быть не должно.
+     *
+     * @param target Текстура, в которую идет отрисовка.
+     * @param warmup_frames Количество кадров до начала замеров.
+     * @param frames Количество замеряемых кадров.
+     * @return Количество выделений памяти за замеряемые кадры (см. GameRenderer::get_frame_allocations).
+     */
+    std::size_t run_game_bench(sf::RenderTexture& target, std::size_t warmup_frames, std::size_t frames)
+    {
+        constexpr int32_t frame_time = 16;
+        constexpr int32_t tick_time = 10;
+        constexpr int32_t click_period = 480;
+
+        sf::Vector2u target_size = target.getSize();
+        GameRenderer game_renderer(sf::FloatRect(0, 0, target_size.x, target_size.y));
+
+        std::vector<double> samples;
+        samples.reserve(frames);
+        int32_t sim_time = 0;
+        int32_t accumulator = 0;
+        std::size_t objects = 0;
+        std::size_t allocations = 0;
+        game_renderer.update(sim_time);
+        for (std::size_t i = 0; i < warmup_frames + frames; ++i)
+        {
+            if (i % (click_period / frame_time) == 0)
+            {
+                click_first(game_renderer, EntityKind::Ice);
+                click_first(game_renderer, EntityKind::Bomb);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (accumulator += frame_time; accumulator >= tick_time; accumulator -= tick_time)
+            {
+                sim_time += tick_time;
+                game_renderer.update(sim_time);
+            }
+            target.clear();
+            game_renderer.draw(target, sim_time - tick_time + accumulator,
+                               static_cast<float>(accumulator) / tick_time);
+            target.display();
+            auto end = std::chrono::steady_clock::now();
+
+            if (i < warmup_frames)
+                continue;
+            samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            objects += game_renderer.get_objects_count();
+            allocations += game_renderer.get_frame_allocations();
+        }
+
+        FrameStats stats = calc_stats(samples);
+        std::cout << std::left << std::setw(10) << "game" << std::right << std::fixed << std::setprecision(2)
+                  << " objects " << std::setw(7) << objects / frames
+                  << "  mean " << std::setw(9) << stats.mean
+                  << "  p50 " << std::setw(9) << stats.p50
+                  << "  p99 " << std::setw(9) << stats.p99
+                  << "  max " << std::setw(9) << stats.max << " us"
+                  << "  allocs " << allocations << std::endl;
+        return allocations;
+    }
+
+    /**
+     * @brief Проверяет, что в установившемся режиме не было выделений памяти.
+     * @param allocations Количество выделений памяти за замеряемые кадры всех сценариев.
+     * @return Код завершения программы (0 - выделений не было).
+     */
+    int check_allocations(std::size_t allocations)
+    {
+        if (allocations == 0)
+            return 0;
+
+        std::cerr << "error: " << allocations << " heap allocations in steady state" << std::endl;
+        return 1;
+    }
+
+    /**
+     * @brief Печатает подсказку по аргументам командной строки.
+     * @param program Имя программы.
+     */
+    void print_usage(const char* program)
+    {
+        std::cerr << "usage: " << program << " [--render] [frames]" << std::endl;
+    }
+
+    /**
+     * @brief Разбирает количество кадров из аргумента.
+     * @param text Текст аргумента (только цифры, от 1 до 100000000).
+     * @param frames Результат (не меняется при ошибке).
+     * @return true, если количество корректно, иначе false.
+     */
+    bool parse_frames(const char* text, std::size_t& frames)
+    {
+        // Только цифры: strtoul разобрал бы и "-1"
+        if (!std::isdigit(static_cast<unsigned char>(text[0])))
+            return false;
+
+        char* end = nullptr;
+        errno = 0;
+        unsigned long value = std::strtoul(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || value < 1 || value > 100000000)
+            return false;
+
+        frames = static_cast<std::size_t>(value);
+        return true;
+    }
+}
+
+/**
+ * Запуск: bench [--render] [frames]
+ *
+ * Без --render замеряется GameRenderer::update, с --render - отрисовка
+ * кадра в sf::RenderTexture при 100, 1000 и 10000 объектах на поле и на
+ * поле в 16 раз больше окна (с отсечением невидимых объектов), пакетом
+ * (batch) и через постоянный буфер вершин (stream). Окно
+ * не создается, поэтому на машине без дисплея и видеокарты замер
+ * запускается с программным OpenGL, например:
+ * LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./bench --render 600
+ *
+ * В каждой строке отчета выводится количество выделений динамической
+ * памяти за замеряемые кадры (после прогрева). В установившемся режиме
+ * игры (замер update и строка game с --render) их быть не должно, иначе
+ * замер завершается с ошибкой.
+ */
+int main(int argc, char** argv)
+{
+    bool render = false;
+    std::size_t frames = 10000;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--render")
+        {
+            render = true;
+        }
+        else if (!parse_frames(argv[i], frames))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Текстуры для замера обновления не обязательны
+    if (!GameRenderer::load_resources())
+    {
+        std::cout << "warning: resources not loaded (run from the app directory)" << std::endl;
+    }
+
+    if (render)
+    {
+        sf::RenderTexture target;
+        if (!target.create(402, 712))
+        {
+            std::cerr << "error: cannot create an offscreen render target (no OpenGL context)" << std::endl;
+            return 1;
+        }
+
+        std::cout << "GameRenderer::draw to sf::RenderTexture, " << frames << " frames" << std::endl;
+        sf::FloatRect screen(0, 0, 402, 712);
+        for (std::size_t population : {100, 1000, 10000})
+        {
+            run_render_bench(target, "batch", GameRenderer::RenderMode::Batch, screen, population, frames / 10, frames);
+            run_render_bench(target, "stream", GameRenderer::RenderMode::Stream, screen, population, frames / 10, frames);
+        }
+
+        // Поле 4x4 окна: рисуется только видимая шестнадцатая часть
+        sf::FloatRect wall(0, 0, screen.width * 4, screen.height * 4);
+        run_render_bench(target, "wall-batch", GameRenderer::RenderMode::Batch, wall, 40000, frames / 10, frames);
+        run_render_bench(target, "wall-strm", GameRenderer::RenderMode::Stream, wall, 40000, frames / 10, frames);
+
+        // Главный цикл игры: обновление и отрисовка. Прогрев не зависит от числа кадров,
+        // пулы должны успеть вырасти до установившегося размера
+        return check_allocations(run_game_bench(target, 1000, frames));
+    }
+
+    std::cout << "GameRenderer::update, " << frames << " frames, kinematics kernel: "
+              << BatchKinematics::get_kernel_name(BatchKinematics::get_kernel()) << std::endl;
+    std::size_t allocations = run_update_bench(GameRenderer::UpdateMode::Separate, "separate", 1, 5000, frames);
+    allocations += run_update_bench(GameRenderer::UpdateMode::Fused, "fused", 1, 5000, frames);
+
+    return check_allocations(allocations);
+}
@@ -0,0 +1,34 @@
+TEMPLATE = lib
+CONFIG += staticlib
+CONFIG -= app_bundle
+CONFIG -= qt
+
+# Симуляция матча без графики: из SFML используются только заголовки
+# sf::Rect и sf::Vector2, поэтому библиотеки SFML не подключаются
+TARGET = blumcore
+
+SOURCES +=  \
+    entitystore.cpp \
+    kinematics.cpp \
+    matchrandom.cpp \
+    matchsimulation.cpp \
+    replay.cpp \
+    spatialgrid.cpp \
+    spawnparams.cpp \
+    threadpool.cpp
+
+HEADERS +=  \
+    entitystore.h \
+    kinematics.h \
+    matchrandom.h \
+    matchsimulation.h \
+    replay.h \
+    spatialgrid.h \
+    spawnparams.h \
+    threadpool.h
+
+# Ядро используется и в замерах, поэтому собирается с оптимизацией
+QMAKE_CXXFLAGS += -Wall -Wextra -Werror -O2
+
+# путь к заголовочным файлам SFML
+INCLUDEPATH += /usr/include
@@ -0,0 +1,263 @@
+#include "entitystore.h"
+
+#include <algorithm>
+#include <cmath>
+
+void EntityStore::reserve(std::size_t capacity)
+{
+    m_pos_x.reserve(capacity);
+    m_pos_y.reserve(capacity);
+    m_prev_x.reserve(capacity);
+    m_prev_y.reserve(capacity);
+    m_width.reserve(capacity);
+    m_height.reserve(capacity);
+    m_dir_x.reserve(capacity);
+    m_dir_y.reserve(capacity);
+    m_speed.reserve(capacity);
+    m_kind.reserve(capacity);
+    m_alive.reserve(capacity);
+    m_activated.reserve(capacity);
+    m_activation_time.reserve(capacity);
+    m_tag.reserve(capacity);
+    m_dense_to_slot.reserve(capacity);
+
+    m_slot_to_dense.reserve(capacity);
+    m_generations.reserve(capacity);
+    m_free_slots.reserve(capacity);
+}
+
+EntityHandle EntityStore::create(EntityKind kind, const sf::FloatRect& rect, const sf::Vector2f& direction, float speed,
+                                 std::uint32_t tag)
+{
+    // Берем свободный слот, если он есть, иначе заводим новый
+    std::uint32_t slot;
+    if (!m_free_slots.empty())
+    {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(m_generations.size());
+        m_generations.push_back(0);
+        m_slot_to_dense.push_back(0);
+    }
+
+    sf::Vector2f direct = normalize(direction);
+
+    // Добавляем данные сущности в конец плотных массивов
+    m_slot_to_dense[slot] = static_cast<std::uint32_t>(m_pos_x.size());
+    m_pos_x.push_back(rect.left);
+    m_pos_y.push_back(rect.top);
+    m_prev_x.push_back(rect.left);
+    m_prev_y.push_back(rect.top);
+    m_width.push_back(rect.width);
+    m_height.push_back(rect.height);
+    m_dir_x.push_back(direct.x);
+    m_dir_y.push_back(direct.y);
+    m_speed.push_back(speed);
+    m_kind.push_back(kind);
+    m_alive.push_back(1);
+    m_activated.push_back(0);
+    m_activation_time.push_back(0);
+    m_tag.push_back(tag);
+    m_dense_to_slot.push_back(slot);
+
+    return EntityHandle{slot, m_generations[slot]};
+}
+
+bool EntityStore::is_valid(EntityHandle handle) const
+{
+    return handle.slot < m_generations.size() &&
+            m_generations[handle.slot] == handle.generation;
+}
+
+std::size_t EntityStore::get_index(EntityHandle handle) const
+{
+    return m_slot_to_dense[handle.slot];
+}
+
+EntityHandle EntityStore::get_handle(std::size_t index) const
+{
+    std::uint32_t slot = m_dense_to_slot[index];
+    return EntityHandle{slot, m_generations[slot]};
+}
+
+std::size_t EntityStore::size(void) const
+{
+    return m_pos_x.size();
+}
+
+bool EntityStore::empty(void) const
+{
+    return m_pos_x.empty();
+}
+
+void EntityStore::clear(void)
+{
+    // Освобождаем все занятые слоты, делая старые дескрипторы недействительными
+    for (std::uint32_t slot : m_dense_to_slot)
+    {
+        release_slot(slot);
+    }
+
+    truncate(0);
+
+    m_last_update_time = -1;
+}
+
+sf::FloatRect EntityStore::get_rect(std::size_t index) const
+{
+    return sf::FloatRect(m_pos_x[index], m_pos_y[index], m_width[index], m_height[index]);
+}
+
+sf::FloatRect EntityStore::get_interpolated_rect(std::size_t index, float alpha) const
+{
+    float x = m_prev_x[index] + (m_pos_x[index] - m_prev_x[index]) * alpha;
+    float y = m_prev_y[index] + (m_pos_y[index] - m_prev_y[index]) * alpha;
+    return sf::FloatRect(x, y, m_width[index], m_height[index]);
+}
+
+EntityKind EntityStore::get_kind(std::size_t index) const
+{
+    return m_kind[index];
+}
+
+std::uint32_t EntityStore::get_tag(std::size_t index) const
+{
+    return m_tag[index];
+}
+
+bool EntityStore::is_alive(std::size_t index) const
+{
+    return m_alive[index] != 0;
+}
+
+void EntityStore::kill(std::size_t index)
+{
+    m_alive[index] = 0;
+}
+
+bool EntityStore::is_activated(std::size_t index) const
+{
+    return m_activated[index] != 0;
+}
+
+void EntityStore::activate(std::size_t index, int32_t cur_time)
+{
+    m_activated[index] = 1;
+    m_activation_time[index] = cur_time;
+}
+
+void EntityStore::kill_expired(int32_t cur_time, const int32_t* durations)
+{
+    std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // Активированная сущность живет, пока проигрывается анимация активации
+        if (m_activated[i] &&
+                cur_time - m_activation_time[i] >= durations[static_cast<std::size_t>(m_kind[i])])
+            m_alive[i] = 0;
+    }
+}
+
+void EntityStore::set_direction_all(const sf::Vector2f& new_direct)
+{
+    sf::Vector2f direct = normalize(new_direct);
+    std::fill(m_dir_x.begin(), m_dir_x.end(), direct.x);
+    std::fill(m_dir_y.begin(), m_dir_y.end(), direct.y);
+}
+
+void EntityStore::move(int32_t cur_time)
+{
+    if (m_last_update_time == -1)
+    {
+        m_last_update_time = cur_time;
+        return;
+    }
+
+    int32_t delta_time = cur_time - m_last_update_time;
+    m_last_update_time = cur_time;
+
+    // Запоминаем позиции до перемещения для интерполяции при отрисовке
+    m_prev_x = m_pos_x;
+    m_prev_y = m_pos_y;
+
+    // Пакетное (векторизованное) перемещение всех сущностей
+    BatchKinematics::advance(m_pos_x.data(), m_pos_y.data(), m_dir_x.data(), m_dir_y.data(),
+                             m_speed.data(), size(), delta_time);
+}
+
+void EntityStore::kill_departed(const sf::FloatRect& sandbox)
+{
+    std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // Если сущность не пересекает область, то она должна быть удалена
+        if (!sandbox.intersects(get_rect(i)))
+            m_alive[i] = 0;
+    }
+}
+
+std::size_t EntityStore::remove_dead(void)
+{
+    return remove_dead([](std::size_t) {});
+}
+
+void EntityStore::relocate(std::size_t from, std::size_t to)
+{
+    std::uint32_t slot = m_dense_to_slot[from];
+
+    m_pos_x[to] = m_pos_x[from];
+    m_pos_y[to] = m_pos_y[from];
+    m_prev_x[to] = m_prev_x[from];
+    m_prev_y[to] = m_prev_y[from];
+    m_width[to] = m_width[from];
+    m_height[to] = m_height[from];
+    m_dir_x[to] = m_dir_x[from];
+    m_dir_y[to] = m_dir_y[from];
+    m_speed[to] = m_speed[from];
+    m_kind[to] = m_kind[from];
+    m_alive[to] = m_alive[from];
+    m_activated[to] = m_activated[from];
+    m_activation_time[to] = m_activation_time[from];
+    m_tag[to] = m_tag[from];
+    m_dense_to_slot[to] = slot;
+    m_slot_to_dense[slot] = static_cast<std::uint32_t>(to);
+}
+
+void EntityStore::release_slot(std::uint32_t slot)
+{
+    // Новое поколение делает старые дескрипторы слота недействительными
+    ++m_generations[slot];
+    m_free_slots.push_back(slot);
+}
+
+void EntityStore::truncate(std::size_t new_size)
+{
+    m_pos_x.resize(new_size);
+    m_pos_y.resize(new_size);
+    m_prev_x.resize(new_size);
+    m_prev_y.resize(new_size);
+    m_width.resize(new_size);
+    m_height.resize(new_size);
+    m_dir_x.resize(new_size);
+    m_dir_y.resize(new_size);
+    m_speed.resize(new_size);
+    m_kind.resize(new_size);
+    m_alive.resize(new_size);
+    m_activated.resize(new_size);
+    m_activation_time.resize(new_size);
+    m_tag.resize(new_size);
+    m_dense_to_slot.resize(new_size);
+}
+
+sf::Vector2f EntityStore::normalize(const sf::Vector2f& direct)
+{
+    float length = std::sqrt(direct.x * direct.x + direct.y * direct.y);
+    if (length != 0.0f)
+    {
+        return direct / length;
+    }
+    return sf::Vector2f(0.f, 0.f);
+}
@@ -0,0 +1,347 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "kinematics.h"
+
+/**
+ * @brief Тип игровой сущности.
+ */
+enum class EntityKind : std::uint8_t
+{
+    Blum, ///< Объект Blum (приносит очки).
+    Ice,  ///< Объект Ice (замораживает игру).
+    Bomb  ///< Объект Bomb (отнимает очки).
+};
+
+/**
+ * @brief Стабильный дескриптор сущности в хранилище.
+ *
+ * Остается корректным, пока сущность жива, даже если при уплотнении
+ * хранилища ее данные переместились на другой индекс.
+ */
+struct EntityHandle
+{
+    std::uint32_t slot = 0;       ///< Номер слота сущности.
+    std::uint32_t generation = 0; ///< Поколение слота на момент создания сущности.
+};
+
+/**
+ * @brief Непрерывное хранилище игровых сущностей в виде структуры массивов.
+ *
+ * Позиции, размеры, направления, скорости, типы и флаги состояния хранятся
+ * в отдельных плотно упакованных массивах, поэтому движение, удаление,
+ * проверка кликов и отрисовка проходят по памяти линейно.
+ * Плотные индексы (0..size()-1) меняются при уплотнении, слоты - нет.
+ */
+class EntityStore
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit EntityStore(void) = default;
+
+    /**
+     * @brief Резервирует память под заданное количество сущностей.
+     * @param capacity Ожидаемое количество одновременно живых сущностей.
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Добавляет новую сущность.
+     * @param kind Тип сущности.
+     * @param rect Начальная позиция и размер сущности.
+     * @param direction Направление движения (будет нормализовано).
+     * @param speed Скорость движения в пикселях в секунду.
+     * @param tag Пользовательская метка (например, номер внешнего вида в пуле).
+     * @return Стабильный дескриптор новой сущности.
+     */
+    EntityHandle create(EntityKind kind, const sf::FloatRect& rect, const sf::Vector2f& direction, float speed,
+                        std::uint32_t tag = 0);
+
+    /**
+     * @brief Проверяет, существует ли еще сущность с данным дескриптором.
+     * @param handle Дескриптор сущности.
+     * @return true, если сущность есть в хранилище, иначе false.
+     */
+    bool is_valid(EntityHandle handle) const;
+
+    /**
+     * @brief Возвращает текущий плотный индекс сущности.
+     * @param handle Корректный дескриптор сущности.
+     * @return Плотный индекс сущности.
+     */
+    std::size_t get_index(EntityHandle handle) const;
+
+    /**
+     * @brief Возвращает дескриптор сущности по плотному индексу.
+     * @param index Плотный индекс сущности.
+     * @return Дескриптор сущности.
+     */
+    EntityHandle get_handle(std::size_t index) const;
+
+    /**
+     * @brief Количество сущностей в хранилище.
+     * @return Количество сущностей.
+     */
+    std::size_t size(void) const;
+
+    /**
+     * @brief Проверяет, пусто ли хранилище.
+     * @return true, если сущностей нет, иначе false.
+     */
+    bool empty(void) const;
+
+    /**
+     * @brief Удаляет все сущности.
+     */
+    void clear(void);
+
+    /**
+     * @brief Получить прямоугольник, описывающий границы сущности.
+     * @param index Плотный индекс сущности.
+     * @return Границы сущности.
+     */
+    sf::FloatRect get_rect(std::size_t index) const;
+
+    /**
+     * @brief Получить границы сущности между двумя последними перемещениями.
+     *
+     * Используется для плавной отрисовки, когда кадры рисуются чаще
+     * или не в такт с шагами симуляции.
+     *
+     * @param index Плотный индекс сущности.
+     * @param alpha Доля шага: 0 - позиция до последнего перемещения, 1 - текущая позиция.
+     * @return Интерполированные границы сущности.
+     */
+    sf::FloatRect get_interpolated_rect(std::size_t index, float alpha) const;
+
+    /**
+     * @brief Получить тип сущности.
+     * @param index Плотный индекс сущности.
+     * @return Тип сущности.
+     */
+    EntityKind get_kind(std::size_t index) const;
+
+    /**
+     * @brief Получить пользовательскую метку сущности.
+     * @param index Плотный индекс сущности.
+     * @return Метка, переданная при создании.
+     */
+    std::uint32_t get_tag(std::size_t index) const;
+
+    /**
+     * @brief Проверить, жива ли сущность.
+     * @param index Плотный индекс сущности.
+     * @return true, если сущность жива, иначе false.
+     */
+    bool is_alive(std::size_t index) const;
+
+    /**
+     * @brief Пометить сущность как мертвую (будет удалена при уплотнении).
+     * @param index Плотный индекс сущности.
+     */
+    void kill(std::size_t index);
+
+    /**
+     * @brief Проверить, активирована ли сущность (по ней уже кликнули).
+     * @param index Плотный индекс сущности.
+     * @return true, если сущность активирована, иначе false.
+     */
+    bool is_activated(std::size_t index) const;
+
+    /**
+     * @brief Активировать сущность.
+     * @param index Плотный индекс сущности.
+     * @param cur_time Время активации в миллисекундах.
+     */
+    void activate(std::size_t index, int32_t cur_time);
+
+    /**
+     * @brief Помечает мертвыми сущности, активированные слишком давно.
+     * @param cur_time Текущее время в миллисекундах.
+     * @param durations Время жизни после активации для каждого типа (индекс - EntityKind).
+     */
+    void kill_expired(int32_t cur_time, const int32_t* durations);
+
+    /**
+     * @brief Устанавливает направление движения всем сущностям.
+     * @param new_direct Новое направление (будет нормализовано).
+     */
+    void set_direction_all(const sf::Vector2f& new_direct);
+
+    /**
+     * @brief Перемещает все сущности в соответствии с deltatime концепцией.
+     *
+     * Первый вызов только запоминает время, как и ObjectLogic::move.
+     * Позиции до перемещения сохраняются для интерполяции.
+     *
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void move(int32_t cur_time);
+
+    /**
+     * @brief Помечает мертвыми сущности, не пересекающие заданную область.
+     * @param sandbox Область, в которой сущности могут находиться.
+     */
+    void kill_departed(const sf::FloatRect& sandbox);
+
+    /**
+     * @brief Удаляет мертвые сущности, сохраняя порядок оставшихся.
+     * @return Количество удаленных сущностей.
+     */
+    std::size_t remove_dead(void);
+
+    /**
+     * @brief Удаляет мертвые сущности, сохраняя порядок оставшихся.
+     *
+     * Для каждой удаляемой сущности перед удалением вызывается on_remove,
+     * например, чтобы вернуть ее внешний вид в пул.
+     *
+     * @tparam OnRemove Функция вида void(std::size_t index).
+     * @param on_remove Обработчик удаления (получает плотный индекс сущности).
+     * @return Количество удаленных сущностей.
+     */
+    template <typename OnRemove>
+    std::size_t remove_dead(OnRemove&& on_remove);
+
+    /**
+     * @brief Совмещенное обновление: перемещение, отсечение и уплотнение за один проход.
+     *
+     * Делает то же, что последовательность move, kill_departed и remove_dead,
+     * но обращается к данным каждой сущности один раз за кадр.
+     *
+     * @tparam OnRemove Функция вида void(std::size_t index).
+     * @param cur_time Текущее время в миллисекундах.
+     * @param sandbox Область, в которой сущности могут находиться.
+     * @param on_remove Обработчик удаления (получает плотный индекс сущности).
+     * @return Количество удаленных сущностей.
+     */
+    template <typename OnRemove>
+    std::size_t update(int32_t cur_time, const sf::FloatRect& sandbox, OnRemove&& on_remove);
+
+private:
+    /**
+     * @brief Переносит данные сущности с одного плотного индекса на другой.
+     * @param from Исходный плотный индекс.
+     * @param to Новый плотный индекс.
+     */
+    void relocate(std::size_t from, std::size_t to);
+
+    /**
+     * @brief Освобождает слот удаленной сущности.
+     * @param slot Номер слота.
+     */
+    void release_slot(std::uint32_t slot);
+
+    /**
+     * @brief Отбрасывает хвост плотных массивов (память остается зарезервированной).
+     * @param new_size Новое количество сущностей.
+     */
+    void truncate(std::size_t new_size);
+
+    /**
+     * @brief Нормализует вектор направления.
+     * @param direct Исходный вектор.
+     * @return Вектор единичной длины или нулевой вектор.
+     */
+    static sf::Vector2f normalize(const sf::Vector2f& direct);
+
+    std::vector<float> m_pos_x;     ///< Позиция по оси X (левый край).
+    std::vector<float> m_pos_y;     ///< Позиция по оси Y (верхний край).
+    std::vector<float> m_prev_x;    ///< Позиция по оси X до последнего перемещения.
+    std::vector<float> m_prev_y;    ///< Позиция по оси Y до последнего перемещения.
+    std::vector<float> m_width;     ///< Ширина сущности.
+    std::vector<float> m_height;    ///< Высота сущности.
+    std::vector<float> m_dir_x;     ///< Направление движения по оси X.
+    std::vector<float> m_dir_y;     ///< Направление движения по оси Y.
+    std::vector<float> m_speed;     ///< Скорость движения.
+    std::vector<EntityKind> m_kind; ///< Тип сущности.
+    std::vector<std::uint8_t> m_alive;     ///< Флаг жизни сущности.
+    std::vector<std::uint8_t> m_activated; ///< Флаг активации сущности.
+    std::vector<int32_t> m_activation_time; ///< Время активации сущности.
+    std::vector<std::uint32_t> m_tag; ///< Пользовательская метка сущности.
+    std::vector<std::uint32_t> m_dense_to_slot; ///< Слот сущности по плотному индексу.
+
+    std::vector<std::uint32_t> m_slot_to_dense; ///< Плотный индекс по слоту.
+    std::vector<std::uint32_t> m_generations;   ///< Текущее поколение каждого слота.
+    std::vector<std::uint32_t> m_free_slots;    ///< Свободные слоты для повторного использования.
+
+    int32_t m_last_update_time = -1; ///< Время последнего перемещения.
+
+    static constexpr std::size_t mc_update_chunk = 256; ///< Размер блока сущностей в совмещенном обновлении.
+};
+
+template <typename OnRemove>
+std::size_t EntityStore::remove_dead(OnRemove&& on_remove)
+{
+    std::size_t n = size();
+    std::size_t write = 0;
+
+    for (std::size_t read = 0; read < n; ++read)
+    {
+        if (!m_alive[read]) // Освобождаем слот мертвой сущности
+        {
+            on_remove(read);
+            release_slot(m_dense_to_slot[read]);
+            continue;
+        }
+
+        if (write != read) // Сдвигаем живую сущность на место удаленных
+            relocate(read, write);
+        ++write;
+    }
+
+    truncate(write);
+    return n - write;
+}
+
+template <typename OnRemove>
+std::size_t EntityStore::update(int32_t cur_time, const sf::FloatRect& sandbox, OnRemove&& on_remove)
+{
+    // При первом вызове только запоминаем время, как и move
+    int32_t delta_time = 0;
+    if (m_last_update_time != -1)
+        delta_time = cur_time - m_last_update_time;
+    m_last_update_time = cur_time;
+
+    std::size_t n = size();
+    std::size_t write = 0;
+
+    // Сущности обрабатываются блоками: блок перемещается векторизованным ядром
+    // и сразу, пока он в кэше, проверяется и уплотняется
+    for (std::size_t chunk = 0; chunk < n; chunk += mc_update_chunk)
+    {
+        std::size_t chunk_end = std::min(n, chunk + mc_update_chunk);
+        std::copy(&m_pos_x[chunk], &m_pos_x[chunk] + (chunk_end - chunk), &m_prev_x[chunk]);
+        std::copy(&m_pos_y[chunk], &m_pos_y[chunk] + (chunk_end - chunk), &m_prev_y[chunk]);
+        BatchKinematics::advance(&m_pos_x[chunk], &m_pos_y[chunk], &m_dir_x[chunk], &m_dir_y[chunk],
+                                 &m_speed[chunk], chunk_end - chunk, delta_time);
+
+        for (std::size_t read = chunk; read < chunk_end; ++read)
+        {
+            // Мертвые и покинувшие область сущности удаляем
+            if (!m_alive[read] || !sandbox.intersects(get_rect(read)))
+            {
+                on_remove(read);
+                release_slot(m_dense_to_slot[read]);
+                continue;
+            }
+
+            if (write != read) // Сдвигаем живую сущность на место удаленных
+                relocate(read, write);
+            ++write;
+        }
+    }
+
+    truncate(write);
+    return n - write;
+}
+
+#endif // ENTITYSTORE_H
@@ -0,0 +1,163 @@
+#include "kinematics.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BLUM_KINEMATICS_X86
+#endif
+
+namespace
+{
+    /**
+     * @brief Скалярное ядро (тот же порядок операций, что и в ObjectLogic::move).
+     */
+    void advance_scalar(float* pos_x, float* pos_y,
+                        const float* dir_x, const float* dir_y, const float* speed,
+                        std::size_t n, float delta_sec)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            pos_x[i] += dir_x[i] * speed[i] * delta_sec;
+            pos_y[i] += dir_y[i] * speed[i] * delta_sec;
+        }
+    }
+
+#ifdef BLUM_KINEMATICS_X86
+    /**
+     * @brief Ядро SSE2: 4 объекта за итерацию, остаток обрабатывается скалярно.
+     */
+    __attribute__((target("sse2")))
+    void advance_sse2(float* pos_x, float* pos_y,
+                      const float* dir_x, const float* dir_y, const float* speed,
+                      std::size_t n, float delta_sec)
+    {
+        const __m128 dt = _mm_set1_ps(delta_sec);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 s = _mm_loadu_ps(speed + i);
+            __m128 x = _mm_loadu_ps(pos_x + i);
+            __m128 y = _mm_loadu_ps(pos_y + i);
+            x = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dir_x + i), s), dt));
+            y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dir_y + i), s), dt));
+            _mm_storeu_ps(pos_x + i, x);
+            _mm_storeu_ps(pos_y + i, y);
+        }
+        advance_scalar(pos_x + i, pos_y + i, dir_x + i, dir_y + i, speed + i, n - i, delta_sec);
+    }
+
+    /**
+     * @brief Ядро AVX2: 8 объектов за итерацию, остаток обрабатывается скалярно.
+     */
+    __attribute__((target("avx2")))
+    void advance_avx2(float* pos_x, float* pos_y,
+                      const float* dir_x, const float* dir_y, const float* speed,
+                      std::size_t n, float delta_sec)
+    {
+        const __m256 dt = _mm256_set1_ps(delta_sec);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 s = _mm256_loadu_ps(speed + i);
+            __m256 x = _mm256_loadu_ps(pos_x + i);
+            __m256 y = _mm256_loadu_ps(pos_y + i);
+            x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(dir_x + i), s), dt));
+            y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(dir_y + i), s), dt));
+            _mm256_storeu_ps(pos_x + i, x);
+            _mm256_storeu_ps(pos_y + i, y);
+        }
+        advance_scalar(pos_x + i, pos_y + i, dir_x + i, dir_y + i, speed + i, n - i, delta_sec);
+    }
+#endif
+
+    /**
+     * @brief Выбирает лучшее ядро, поддерживаемое процессором.
+     * @return Ядро для использования по умолчанию.
+     */
+    BatchKinematics::Kernel detect_kernel(void)
+    {
+        if (BatchKinematics::is_supported(BatchKinematics::Kernel::Avx2))
+            return BatchKinematics::Kernel::Avx2;
+        if (BatchKinematics::is_supported(BatchKinematics::Kernel::Sse2))
+            return BatchKinematics::Kernel::Sse2;
+        return BatchKinematics::Kernel::Scalar;
+    }
+
+    /**
+     * @brief Текущее ядро (определяется при первом обращении).
+     * @return Ссылка на текущее ядро.
+     */
+    BatchKinematics::Kernel& current_kernel(void)
+    {
+        static BatchKinematics::Kernel kernel = detect_kernel();
+        return kernel;
+    }
+}
+
+void BatchKinematics::advance(float* pos_x, float* pos_y,
+                              const float* dir_x, const float* dir_y, const float* speed,
+                              std::size_t n, int32_t delta_time)
+{
+    float delta_sec = delta_time / 1000.0f;
+
+    switch (current_kernel())
+    {
+#ifdef BLUM_KINEMATICS_X86
+    case Kernel::Avx2:
+        advance_avx2(pos_x, pos_y, dir_x, dir_y, speed, n, delta_sec);
+        break;
+    case Kernel::Sse2:
+        advance_sse2(pos_x, pos_y, dir_x, dir_y, speed, n, delta_sec);
+        break;
+#endif
+    default:
+        advance_scalar(pos_x, pos_y, dir_x, dir_y, speed, n, delta_sec);
+        break;
+    }
+}
+
+BatchKinematics::Kernel BatchKinematics::get_kernel(void)
+{
+    return current_kernel();
+}
+
+bool BatchKinematics::set_kernel(Kernel kernel)
+{
+    if (!is_supported(kernel))
+        return false;
+
+    current_kernel() = kernel;
+    return true;
+}
+
+bool BatchKinematics::is_supported(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::Scalar:
+        return true;
+#ifdef BLUM_KINEMATICS_X86
+    case Kernel::Sse2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case Kernel::Avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* BatchKinematics::get_kernel_name(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::Sse2:
+        return "sse2";
+    case Kernel::Avx2:
+        return "avx2";
+    case Kernel::Scalar:
+    default:
+        return "scalar";
+    }
+}
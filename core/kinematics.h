@@ -0,0 +1,75 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Пакетное перемещение множества объектов за один вызов.
+ *
+ * Выполняет для N объектов то же, что ObjectLogic::move для одного:
+ * позиция += направление * скорость * (delta_time / 1000).
+ * Данные передаются отдельными массивами (структура массивов), поэтому
+ * вычисление векторизуется. Ядро (скалярное, SSE2 или AVX2) выбирается
+ * при первом вызове по возможностям процессора (CPUID).
+ */
+class BatchKinematics
+{
+public:
+    /**
+     * @brief Реализация вычислений.
+     */
+    enum class Kernel
+    {
+        Scalar, ///< Обычный цикл без SIMD.
+        Sse2,   ///< 4 объекта за итерацию (SSE2).
+        Avx2    ///< 8 объектов за итерацию (AVX2).
+    };
+
+    /**
+     * @brief Перемещает n объектов.
+     *
+     * @param pos_x Позиции по оси X (изменяются).
+     * @param pos_y Позиции по оси Y (изменяются).
+     * @param dir_x Направления движения по оси X.
+     * @param dir_y Направления движения по оси Y.
+     * @param speed Скорости движения.
+     * @param n Количество объектов.
+     * @param delta_time Прошедшее время в миллисекундах.
+     */
+    static void advance(float* pos_x, float* pos_y,
+                        const float* dir_x, const float* dir_y, const float* speed,
+                        std::size_t n, int32_t delta_time);
+
+    /**
+     * @brief Получить используемое ядро.
+     * @return Текущее ядро.
+     */
+    static Kernel get_kernel(void);
+
+    /**
+     * @brief Принудительно выбрать ядро (для тестов и замеров).
+     *
+     * Не потокобезопасно: вызывать, пока advance не выполняется в других потоках.
+     *
+     * @param kernel Желаемое ядро.
+     * @return true, если ядро поддерживается процессором и выбрано, иначе false.
+     */
+    static bool set_kernel(Kernel kernel);
+
+    /**
+     * @brief Проверить, поддерживает ли процессор ядро.
+     * @param kernel Проверяемое ядро.
+     * @return true, если ядро можно использовать, иначе false.
+     */
+    static bool is_supported(Kernel kernel);
+
+    /**
+     * @brief Получить название ядра.
+     * @param kernel Ядро.
+     * @return Название ядра ("scalar", "sse2", "avx2").
+     */
+    static const char* get_kernel_name(Kernel kernel);
+};
+
+#endif // KINEMATICS_H
@@ -0,0 +1,41 @@
+#include "matchrandom.h"
+
+MatchRandom::MatchRandom(std::uint64_t seed)
+{
+    this->seed(seed);
+}
+
+void MatchRandom::seed(std::uint64_t seed)
+{
+    // Стандартная инициализация PCG32: последовательность выбирается
+    // по старшим битам начального значения, позиция - по всему значению
+    m_state = 0;
+    m_inc = ((seed >> 32) << 1) | 1u;
+    (*this)();
+    m_state += seed;
+    (*this)();
+}
+
+std::uint32_t MatchRandom::operator()(void)
+{
+    std::uint64_t old_state = m_state;
+    m_state = old_state * 6364136223846793005ull + m_inc;
+
+    // Перестановка битов старого состояния (xorshift + случайный поворот)
+    std::uint32_t xorshifted = static_cast<std::uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+    std::uint32_t rot = static_cast<std::uint32_t>(old_state >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+std::uint32_t MatchRandom::below(std::uint32_t bound)
+{
+    // Умножение вместо деления (метод Лемира); смещение не превышает bound / 2^32
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>((*this)()) * bound) >> 32);
+}
+
+float MatchRandom::uniform(float min, float max)
+{
+    // Старшие 24 бита дают равномерное число в [0, 1) с точностью float
+    float unit = ((*this)() >> 8) * (1.f / 16777216.f);
+    return min + (max - min) * unit;
+}
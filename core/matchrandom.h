@@ -0,0 +1,71 @@
+#ifndef MATCHRANDOM_H
+#define MATCHRANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Быстрый генератор случайных чисел матча (PCG32).
+ *
+ * Состояние занимает 16 байт, инициализация и получение числа стоят
+ * несколько арифметических операций. Последовательность полностью
+ * определяется начальным значением, поэтому матч воспроизводим.
+ * Удовлетворяет требованиям UniformRandomBitGenerator и может
+ * использоваться со стандартными распределениями.
+ */
+class MatchRandom
+{
+public:
+    using result_type = std::uint32_t; ///< Тип генерируемых чисел.
+
+    /**
+     * @brief Конструктор с начальным значением.
+     * @param seed Начальное значение генератора.
+     */
+    explicit MatchRandom(std::uint64_t seed = 0);
+
+    /**
+     * @brief Переинициализирует генератор.
+     * @param seed Начальное значение генератора.
+     */
+    void seed(std::uint64_t seed);
+
+    /**
+     * @brief Следующее случайное 32-битное число.
+     * @return Случайное число.
+     */
+    std::uint32_t operator()(void);
+
+    /**
+     * @brief Случайное целое число в диапазоне [0, bound).
+     * @param bound Верхняя граница (не включается), больше нуля.
+     * @return Случайное число.
+     */
+    std::uint32_t below(std::uint32_t bound);
+
+    /**
+     * @brief Случайное число с плавающей точкой в диапазоне [min, max).
+     * @param min Нижняя граница.
+     * @param max Верхняя граница.
+     * @return Случайное число.
+     */
+    float uniform(float min, float max);
+
+    /**
+     * @brief Минимальное генерируемое значение.
+     * @return 0.
+     */
+    static constexpr result_type min(void) { return 0; }
+
+    /**
+     * @brief Максимальное генерируемое значение.
+     * @return Максимальное 32-битное число.
+     */
+    static constexpr result_type max(void) { return std::numeric_limits<result_type>::max(); }
+
+private:
+    std::uint64_t m_state = 0; ///< Состояние генератора.
+    std::uint64_t m_inc = 1;   ///< Приращение (задает одну из независимых последовательностей).
+};
+
+#endif // MATCHRANDOM_H
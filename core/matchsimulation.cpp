@@ -0,0 +1,353 @@
+#include "matchsimulation.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Конструктор класса MatchSimulation
+MatchSimulation::MatchSimulation(const sf::FloatRect& game_board, std::uint64_t seed)
+    : m_seed(seed),
+      m_game_board(game_board),
+      // Объекты могут находиться на поле и в зоне появления над ним
+      m_sandbox(game_board.left, game_board.top - 100.f,
+                game_board.width, game_board.height + 100.f),
+      m_grid(m_sandbox, mc_grid_cell_size),
+      m_random(seed)
+{
+    // Резервируем память, чтобы не перераспределять ее во время игры
+    m_entities.reserve(256);
+    m_grid.reserve(256);
+}
+
+// Установка получателя событий
+void MatchSimulation::set_observer(MatchObserver* observer)
+{
+    m_observer = observer;
+}
+
+// Метод обновления матча
+void MatchSimulation::update(int32_t cur_time)
+{
+    if (m_start_time == -1)
+        m_start_time = cur_time;
+    m_cur_time = cur_time;
+    ++m_tick;
+
+    update_entities(cur_time); // Движение и удаление объектов
+    spawn_objects(); // Создание новых объектов (начнут движение со следующего кадра)
+    update_timer(cur_time); // Обновление таймера и заморозки
+
+    // Объекты сдвинулись, сетка перестроится при первом клике
+    m_grid_dirty = true;
+}
+
+// Обработка клика
+void MatchSimulation::click(const sf::Vector2f& mouse_pos)
+{
+    // Сетку перестраиваем не чаще одного раза за кадр и только если был клик
+    if (m_grid_dirty)
+    {
+        m_grid.rebuild(m_entities);
+        m_grid_dirty = false;
+    }
+
+    bool was_hit = false;
+    std::size_t bomb_hits = 0;
+    // Проверяем только объекты из ячейки под курсором (индексы по возрастанию)
+    SpatialGrid::Cell cell = m_grid.query(mouse_pos);
+    if (m_click_policy == ClickPolicy::Topmost)
+    {
+        // Верхний объект отрисован последним, поэтому идем с конца
+        for (const std::uint32_t* it = cell.end(); it != cell.begin() && !was_hit; )
+        {
+            --it;
+            was_hit = try_press_entity(*it, mouse_pos, bomb_hits);
+        }
+    }
+    else
+    {
+        for (std::uint32_t index : cell)
+        {
+            if (try_press_entity(index, mouse_pos, bomb_hits))
+                was_hit = true;
+        }
+    }
+
+    // Штрафы за бомбы применяем после начисления за Blum
+    for (std::size_t i = 0; i < bomb_hits; ++i)
+    {
+        // Уменьшаем счет
+        m_cash = std::max(0, m_cash - 100);
+    }
+
+    if (!was_hit)
+        m_statistics["miss"] += 1; // Если промах, увеличиваем счетчик промахов
+}
+
+// Выбор способа обновления
+void MatchSimulation::set_update_mode(UpdateMode mode)
+{
+    m_update_mode = mode;
+}
+
+// Настройка правила обработки клика
+void MatchSimulation::set_click_policy(ClickPolicy policy)
+{
+    m_click_policy = policy;
+}
+
+// Настройка вероятностей появления объектов
+void MatchSimulation::set_spawn_chances(std::size_t blum, std::size_t ice, std::size_t bomb)
+{
+    m_blum_probability = blum;
+    m_ice_probability = ice;
+    m_bomb_probability = bomb;
+}
+
+// Объекты матча
+const EntityStore& MatchSimulation::get_entities(void) const
+{
+    return m_entities;
+}
+
+// Проверка окончания матча
+bool MatchSimulation::is_game_over(void) const
+{
+    return m_time_passed > mc_match_time; // Возвращает true, если время игры истекло
+}
+
+// Проверка режима заморозки
+bool MatchSimulation::is_freezing(void) const
+{
+    return m_is_freezing;
+}
+
+// Текущий счет
+int MatchSimulation::get_cash(void) const
+{
+    return m_cash;
+}
+
+// Оставшееся время
+int32_t MatchSimulation::get_seconds_left(void) const
+{
+    int32_t seconds_passed = m_time_passed / 1000;  // Переводим в секунды
+    return mc_match_time / 1000 - seconds_passed; // Вычисляем сколько осталось
+}
+
+// Начальное значение генератора
+std::uint64_t MatchSimulation::get_seed(void) const
+{
+    return m_seed;
+}
+
+// Количество обновлений
+std::uint32_t MatchSimulation::get_tick(void) const
+{
+    return m_tick;
+}
+
+// Контрольная сумма состояния
+std::uint32_t MatchSimulation::get_checksum(void) const
+{
+    std::uint32_t hash = 2166136261u;
+    auto mix = [&hash](std::uint32_t value) {
+        // FNV-1a по байтам значения
+        for (int i = 0; i < 4; ++i)
+        {
+            hash = (hash ^ (value & 0xFFu)) * 16777619u;
+            value >>= 8;
+        }
+    };
+    auto mix_float = [&mix](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(bits);
+    };
+
+    mix(m_tick);
+    mix(static_cast<std::uint32_t>(m_cash));
+    mix(static_cast<std::uint32_t>(m_time_passed));
+    mix(m_is_freezing);
+
+    std::size_t n = m_entities.size();
+    mix(static_cast<std::uint32_t>(n));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        sf::FloatRect rect = m_entities.get_rect(i);
+        mix_float(rect.left);
+        mix_float(rect.top);
+        mix(static_cast<std::uint32_t>(m_entities.get_kind(i)));
+        mix(m_entities.is_activated(i));
+    }
+    return hash;
+}
+
+// Статистика матча
+const std::map<std::string, std::size_t, std::less<>>& MatchSimulation::get_statistics(void) const
+{
+    return m_statistics;
+}
+
+// Время жизни после нажатия
+int32_t MatchSimulation::get_activation_time(EntityKind kind)
+{
+    return mc_activation_time[static_cast<std::size_t>(kind)];
+}
+
+// Движение и удаление объектов
+void MatchSimulation::update_entities(int32_t cur_time)
+{
+    auto on_remove = [this](std::size_t index) {
+        notify_remove(index);
+    };
+
+    // Нажатые объекты исчезают, когда заканчивается их анимация активации
+    m_entities.kill_expired(cur_time, mc_activation_time);
+
+    if (m_update_mode == UpdateMode::Fused)
+    {
+        // Перемещение, отсечение и уплотнение объектов за один проход
+        m_entities.update(cur_time, m_sandbox, on_remove);
+    }
+    else
+    {
+        // Перемещаем объекты в соответствии с deltatime концепцией
+        m_entities.move(cur_time);
+        // Определяем вышедшие за границы объекты и помечаем их умершими
+        m_entities.kill_departed(m_sandbox);
+        // Определяем умершие элементы и удаляем их
+        m_entities.remove_dead(on_remove);
+    }
+}
+
+// Обновление таймера и заморозки
+void MatchSimulation::update_timer(int32_t cur_time)
+{
+    if (!m_is_freezing) // Если мы не в заморозке
+    {
+        // Рассчитываем пройденной вермя как промежуток между текущим моментом
+        // и началом, без времени в заморозке
+        m_time_passed = cur_time - m_start_time - m_time_in_freezing_mode;
+    }
+    else
+    {
+        // Увеличиваем общее время в режиме заморозки
+        m_time_in_freezing_mode += cur_time - m_last_freeze_time;
+
+        if (m_freeze_start_time == -1) // Если мы впервые заморозились
+        {
+            freeze_elements();  // Замораживаем все элементы
+            m_freeze_start_time = cur_time; // Запоминаем время когда мы начали
+        }
+        if (m_freeze_start_time != -1 &&  // Если мы в заморозке слишком долго
+                cur_time - m_freeze_start_time >= mc_freeze_time)
+        {
+            m_is_freezing = false; // Выходим из заморозки
+
+            unfreeze_elements();    // Размораживаем все элементы
+            m_freeze_start_time = -1; // Очищаем стартовое время
+        }
+    }
+    m_last_freeze_time = cur_time;
+}
+
+// Создание новых объектов
+void MatchSimulation::spawn_objects(void)
+{
+    if (!m_is_freezing) // Если мы не в режиме заморозки
+    {
+        // Определяем, какие элементы появятся, с заданной для их типа вероятностью
+        EntityKind kinds[3];
+        std::size_t count = 0;
+        if (should_spawn_object(m_blum_probability))
+            kinds[count++] = EntityKind::Blum;
+
+        if (should_spawn_object(m_bomb_probability))
+            kinds[count++] = EntityKind::Bomb;
+
+        if (should_spawn_object(m_ice_probability))
+            kinds[count++] = EntityKind::Ice;
+
+        // Параметры всех новых элементов генерируем одним вызовом
+        SpawnParams params[3];
+        make_spawn_params(m_game_board, m_random, params, count);
+        for (std::size_t i = 0; i < count; ++i)
+            spawn_entity(kinds[i], params[i]);
+    }
+}
+
+// Создание одного объекта
+void MatchSimulation::spawn_entity(EntityKind kind, const SpawnParams& params)
+{
+    // Представление может связать с объектом свои данные через метку
+    std::uint32_t tag = 0;
+    if (m_observer)
+        tag = m_observer->on_spawn(kind, params);
+
+    m_entities.create(kind, sf::FloatRect(params.position, params.size),
+                      params.direction, params.speed, tag);
+}
+
+// Нажатие на один объект
+bool MatchSimulation::try_press_entity(std::size_t index, const sf::Vector2f& mouse_pos, std::size_t& bomb_hits)
+{
+    if (m_entities.is_activated(index)) // Этот объект уже активирован
+        return false;
+
+    sf::FloatRect rect = m_entities.get_rect(index);
+    if (!rect.contains(mouse_pos)) // Нет пересечения с объектом
+        return false;
+
+    m_entities.activate(index, m_cur_time); // Активируем объект
+
+    EntityKind kind = m_entities.get_kind(index);
+    switch (kind)
+    {
+    case EntityKind::Blum:
+        m_cash += 1; // Увеличиваем счетчик
+        m_statistics["blum"] += 1; // Обновляем статистику
+        break;
+
+    case EntityKind::Ice:
+        m_is_freezing = true; // Включаем заморозку
+        m_freeze_start_time = -1; // Сбрасываем время заморозки
+        m_statistics["ice"] += 1; // Обновляем статистику
+        break;
+
+    case EntityKind::Bomb:
+        m_statistics["bomb"] += 1; // Обновляем статистику
+        ++bomb_hits;
+        break;
+    }
+
+    if (m_observer)
+        m_observer->on_hit(kind, m_entities.get_tag(index), rect);
+    return true;
+}
+
+// Уведомление об удалении объекта
+void MatchSimulation::notify_remove(std::size_t index)
+{
+    if (m_observer)
+        m_observer->on_remove(m_entities.get_kind(index), m_entities.get_tag(index));
+}
+
+// Заморозка объектов
+void MatchSimulation::freeze_elements(void)
+{
+    m_entities.set_direction_all(sf::Vector2f(0.f, 0.f));
+}
+
+// Разморозка объектов
+void MatchSimulation::unfreeze_elements(void)
+{
+    m_entities.set_direction_all(sf::Vector2f(0.f, 1.f));
+}
+
+// Проверка нужно ли создать новый объект
+bool MatchSimulation::should_spawn_object(std::size_t chance)
+{
+    std::size_t cur_num = m_random.below(1001); // генерируем случайное число от 0 до 1000
+
+    return cur_num < chance;
+}
@@ -0,0 +1,303 @@
+#ifndef MATCHSIMULATION_H
+#define MATCHSIMULATION_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "entitystore.h"
+#include "matchrandom.h"
+#include "spatialgrid.h"
+#include "spawnparams.h"
+
+/**
+ * @brief Интерфейс получателя событий матча.
+ *
+ * Через него представление (например, GameRenderer) узнает о появлении,
+ * удалении и нажатии объектов, чтобы создавать и освобождать их внешний вид
+ * и запускать эффекты. Симуляция без представления работает и без него.
+ */
+class MatchObserver
+{
+public:
+    /**
+     * @brief Виртуальный деструктор по умолчанию.
+     */
+    virtual ~MatchObserver() = default;
+
+    /**
+     * @brief Вызывается при появлении нового объекта.
+     * @param kind Тип объекта.
+     * @param params Параметры появления объекта.
+     * @return Метка, которая будет сохранена в объекте (например, номер внешнего вида).
+     */
+    virtual std::uint32_t on_spawn(EntityKind kind, const SpawnParams& params) = 0;
+
+    /**
+     * @brief Вызывается перед удалением объекта из матча.
+     * @param kind Тип объекта.
+     * @param tag Метка объекта, возвращенная on_spawn.
+     */
+    virtual void on_remove(EntityKind kind, std::uint32_t tag) = 0;
+
+    /**
+     * @brief Вызывается при нажатии на объект.
+     * @param kind Тип объекта.
+     * @param tag Метка объекта, возвращенная on_spawn.
+     * @param rect Границы объекта в момент нажатия.
+     */
+    virtual void on_hit(EntityKind kind, std::uint32_t tag, const sf::FloatRect& rect) = 0;
+};
+
+/**
+ * @brief Полная симуляция одного матча без графики.
+ *
+ * Содержит все правила игры: появление объектов, их движение, обработку
+ * кликов, заморозку, штраф за бомбу, таймер матча и статистику. Не зависит
+ * от текстур и окна, поэтому может запускаться без графики, например для
+ * нагрузочных тестов и проверки матчей на сервере.
+ */
+class MatchSimulation
+{
+public:
+    /**
+     * @brief Способ обновления игровых объектов за кадр.
+     */
+    enum class UpdateMode
+    {
+        Separate, ///< Отдельные проходы: перемещение, отсечение вышедших, удаление мертвых.
+        Fused     ///< Один совмещенный проход по хранилищу.
+    };
+
+    /**
+     * @brief Правило обработки клика по перекрывающимся объектам.
+     */
+    enum class ClickPolicy
+    {
+        AllOverlapping, ///< Активируются все объекты под курсором.
+        Topmost         ///< Активируется только верхний (последний отрисованный) объект.
+    };
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit MatchSimulation(void) = default;
+
+    /**
+     * @brief Конструктор с указанием размеров игрового поля.
+     * @param game_board Прямоугольник, задающий границы игрового поля.
+     * @param seed Начальное значение генератора случайных чисел матча (матч полностью определяется им и кликами).
+     */
+    explicit MatchSimulation(const sf::FloatRect& game_board, std::uint64_t seed);
+
+    /**
+     * @brief Устанавливает получателя событий матча.
+     * @param observer Получатель событий (nullptr - без получателя).
+     */
+    void set_observer(MatchObserver* observer);
+
+    /**
+     * @brief Обновляет состояние матча на основе текущего времени.
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void update(int32_t cur_time);
+
+    /**
+     * @brief Обрабатывает клик по игровому полю.
+     * @param mouse_pos Позиция клика.
+     */
+    void click(const sf::Vector2f& mouse_pos);
+
+    /**
+     * @brief Устанавливает способ обновления объектов (для сравнения производительности).
+     * @param mode Способ обновления.
+     */
+    void set_update_mode(UpdateMode mode);
+
+    /**
+     * @brief Устанавливает правило обработки клика по перекрывающимся объектам.
+     * @param policy Правило обработки клика.
+     */
+    void set_click_policy(ClickPolicy policy);
+
+    /**
+     * @brief Устанавливает вероятности появления объектов в каждом кадре.
+     * @param blum Вероятность появления Blum (от 0 до 1000).
+     * @param ice Вероятность появления Ice (от 0 до 1000).
+     * @param bomb Вероятность появления Bomb (от 0 до 1000).
+     */
+    void set_spawn_chances(std::size_t blum, std::size_t ice, std::size_t bomb);
+
+    /**
+     * @brief Объекты матча.
+     * @return Хранилище объектов.
+     */
+    const EntityStore& get_entities(void) const;
+
+    /**
+     * @brief Проверяет, завершен ли матч.
+     * @return True, если время матча истекло, false в противном случае.
+     */
+    bool is_game_over(void) const;
+
+    /**
+     * @brief Проверяет, заморожена ли игра.
+     * @return True, если игра в режиме заморозки, false в противном случае.
+     */
+    bool is_freezing(void) const;
+
+    /**
+     * @brief Текущий счет игрока.
+     * @return Количество очков.
+     */
+    int get_cash(void) const;
+
+    /**
+     * @brief Оставшееся время матча.
+     * @return Количество оставшихся секунд.
+     */
+    int32_t get_seconds_left(void) const;
+
+    /**
+     * @brief Начальное значение генератора случайных чисел матча.
+     * @return Начальное значение, переданное в конструктор.
+     */
+    std::uint64_t get_seed(void) const;
+
+    /**
+     * @brief Количество выполненных обновлений (шагов симуляции).
+     * @return Количество вызовов update.
+     */
+    std::uint32_t get_tick(void) const;
+
+    /**
+     * @brief Контрольная сумма состояния матча.
+     *
+     * Учитывает счет, время, заморозку и позиции и состояние всех объектов.
+     * Используется для проверки того, что воспроизведение повторяет матч.
+     *
+     * @return Контрольная сумма (FNV-1a).
+     */
+    std::uint32_t get_checksum(void) const;
+
+    /**
+     * @brief Статистика матча (количество нажатий по типам и промахов).
+     * @return Карта статистики.
+     */
+    const std::map<std::string, std::size_t, std::less<>>& get_statistics(void) const;
+
+    /**
+     * @brief Время жизни объекта после нажатия.
+     *
+     * Равно длительности анимации активации его внешнего вида (кадры на
+     * время смены кадра), чтобы объект исчезал сразу после ее окончания.
+     *
+     * @param kind Тип объекта.
+     * @return Время в миллисекундах.
+     */
+    static int32_t get_activation_time(EntityKind kind);
+
+private:
+    /**
+     * @brief Перемещает объекты и удаляет мертвые и вышедшие за поле.
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void update_entities(int32_t cur_time);
+
+    /**
+     * @brief Обновляет таймер матча и режим заморозки.
+     * @param cur_time Текущее время в миллисекундах.
+     */
+    void update_timer(int32_t cur_time);
+
+    /**
+     * @brief Создает новые игровые объекты.
+     */
+    void spawn_objects(void);
+
+    /**
+     * @brief Создает объект заданного типа над игровым полем.
+     * @param kind Тип создаваемого объекта.
+     * @param params Параметры появления объекта.
+     */
+    void spawn_entity(EntityKind kind, const SpawnParams& params);
+
+    /**
+     * @brief Активирует объект, если клик попал в него.
+     * @param index Плотный индекс объекта в хранилище.
+     * @param mouse_pos Позиция клика.
+     * @param bomb_hits Счетчик попаданий по бомбам (увеличивается при попадании).
+     * @return True, если объект был активирован, false в противном случае.
+     */
+    bool try_press_entity(std::size_t index, const sf::Vector2f& mouse_pos, std::size_t& bomb_hits);
+
+    /**
+     * @brief Сообщает получателю событий об удалении объекта.
+     * @param index Плотный индекс объекта в хранилище.
+     */
+    void notify_remove(std::size_t index);
+
+    /**
+     * @brief Замораживает элементы игры.
+     */
+    void freeze_elements(void);
+
+    /**
+     * @brief Размораживает элементы игры.
+     */
+    void unfreeze_elements(void);
+
+    /**
+     * @brief Определяет, должен ли объект появиться на основе вероятности.
+     * @param chance Вероятность появления объекта (от 0 до 1000).
+     * @return True, если объект должен появиться, false в противном случае.
+     */
+    bool should_spawn_object(std::size_t chance);
+
+    bool m_is_freezing = false; ///< Флаг, указывающий на нахождение игры в режиме заморозки.
+
+    int m_cash = 0; ///< Внутриигровая валюта игрока.
+
+    static constexpr int32_t mc_freeze_time = 2000; ///< Продолжительность заморозки в миллисекундах (2 секунды).
+    static constexpr int32_t mc_match_time = 45000; ///< Общее время матча в миллисекундах (45 секунд).
+    static constexpr int32_t mc_activation_time[3] = {450, 800, 600}; ///< Время жизни после нажатия по типам (длительность анимации активации).
+    static constexpr float mc_grid_cell_size = 48.f; ///< Сторона ячейки сетки (не меньше самого крупного объекта).
+
+    std::uint64_t m_seed = 0; ///< Начальное значение генератора случайных чисел.
+    std::uint32_t m_tick = 0; ///< Количество выполненных обновлений.
+    int32_t m_cur_time = 0; ///< Время последнего обновления.
+    int32_t m_start_time = -1; ///< Время начала игры.
+    int32_t m_time_passed = 0; ///< Прошедшее время с начала игры.
+    int32_t m_time_in_freezing_mode = 0; ///< Время, проведенное в режиме заморозки.
+    int32_t m_last_freeze_time = -1; ///< Последнее время, когда была заморозка.
+    int32_t m_freeze_start_time = -1; ///< Время начала заморозки.
+
+    sf::FloatRect m_game_board; ///< Прямоугольник, определяющий область игрового поля.
+    sf::FloatRect m_sandbox; ///< Область, в которой могут находиться объекты (поле и зона появления над ним).
+    UpdateMode m_update_mode = UpdateMode::Fused; ///< Способ обновления объектов.
+
+    EntityStore m_entities; ///< Хранилище объектов Blum, Ice и Bomb в игре.
+    SpatialGrid m_grid; ///< Сетка для поиска объектов под курсором.
+    bool m_grid_dirty = true; ///< Флаг, указывающий, что сетку нужно перестроить перед следующим кликом.
+    ClickPolicy m_click_policy = ClickPolicy::AllOverlapping; ///< Правило обработки клика.
+    MatchObserver* m_observer = nullptr; ///< Получатель событий матча.
+
+    std::size_t m_bomb_probability = 2; ///< Вероятность появления бомб (от 0 до 1000).
+    std::size_t m_ice_probability = 2; ///< Вероятность появления льда (от 0 до 1000).
+    std::size_t m_blum_probability = 100; ///< Вероятность появления Blum (от 0 до 1000).
+
+    MatchRandom m_random; ///< Генератор случайных чисел матча.
+
+    std::map<std::string, std::size_t, std::less<>> m_statistics = ///< Карта для хранения игровой статистики.
+    {
+        {"miss", 0},
+        {"bomb", 0},
+        {"ice",  0},
+        {"blum", 0}
+    };
+};
+
+#endif // MATCHSIMULATION_H
@@ -0,0 +1,400 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#include "matchsimulation.h"
+
+namespace
+{
+    const char c_magic[4] = {'B', 'L', 'R', 'P'}; // Сигнатура файла повтора
+    constexpr std::uint8_t c_version = 1;          // Версия формата
+
+    // Типы событий (младшие два бита начала события)
+    constexpr std::uint32_t c_event_click = 0;
+    constexpr std::uint32_t c_event_checksum = 1;
+    constexpr std::uint32_t c_event_end = 2;
+
+    // Число переменной длины: по 7 бит на байт, старший бит - признак продолжения
+    std::size_t put_varint(std::uint8_t* out, std::uint64_t value)
+    {
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            out[size++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = static_cast<std::uint8_t>(value);
+        return size;
+    }
+
+    // Знаковое число в беззнаковое так, чтобы малые по модулю значения были короткими
+    std::uint32_t zigzag(std::int32_t value)
+    {
+        return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    std::int32_t unzigzag(std::uint32_t value)
+    {
+        return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+    }
+
+    std::size_t put_u32(std::uint8_t* out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        return 4;
+    }
+
+    std::size_t put_float(std::uint8_t* out, float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return put_u32(out, bits);
+    }
+
+    /**
+     * @brief Последовательное чтение закодированных значений из памяти.
+     */
+    class ReplayReader
+    {
+    public:
+        explicit ReplayReader(const std::vector<std::uint8_t>& data)
+            : m_data(data)
+        {
+        }
+
+        bool get_varint(std::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (m_pos >= m_data.size())
+                    return false;
+                std::uint8_t byte = m_data[m_pos++];
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false; // Слишком длинное число - файл поврежден
+        }
+
+        bool get_varint32(std::uint32_t& value)
+        {
+            std::uint64_t wide;
+            if (!get_varint(wide) || wide > 0xFFFFFFFFull)
+                return false;
+            value = static_cast<std::uint32_t>(wide);
+            return true;
+        }
+
+        bool get_u32(std::uint32_t& value)
+        {
+            if (m_data.size() - m_pos < 4)
+                return false;
+            value = 0;
+            for (int i = 0; i < 4; ++i)
+                value |= static_cast<std::uint32_t>(m_data[m_pos++]) << (8 * i);
+            return true;
+        }
+
+        bool get_float(float& value)
+        {
+            std::uint32_t bits;
+            if (!get_u32(bits))
+                return false;
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+        bool get_bytes(void* out, std::size_t size)
+        {
+            if (m_data.size() - m_pos < size)
+                return false;
+            std::memcpy(out, m_data.data() + m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        bool at_end(void) const
+        {
+            return m_pos >= m_data.size();
+        }
+
+    private:
+        const std::vector<std::uint8_t>& m_data;
+        std::size_t m_pos = 0;
+    };
+}
+
+ReplayWriter::ReplayWriter(std::size_t capacity)
+{
+    std::size_t size = 64;
+    while (size < capacity)
+        size <<= 1;
+    m_ring.resize(size);
+    m_mask = size - 1;
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    if (m_open)
+        finish(m_last_tick);
+}
+
+bool ReplayWriter::open(const std::string& path, const ReplayHeader& header)
+{
+    if (m_open)
+        return false;
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+
+    // Заголовок пишется сразу, он нужен до первого события
+    std::uint8_t buffer[64];
+    std::size_t size = 0;
+    std::memcpy(buffer, c_magic, sizeof(c_magic));
+    size += sizeof(c_magic);
+    buffer[size++] = c_version;
+    size += put_varint(buffer + size, header.seed);
+    size += put_varint(buffer + size, static_cast<std::uint32_t>(header.tick_time));
+    size += put_varint(buffer + size, header.checksum_interval);
+    size += put_float(buffer + size, header.game_board.left);
+    size += put_float(buffer + size, header.game_board.top);
+    size += put_float(buffer + size, header.game_board.width);
+    size += put_float(buffer + size, header.game_board.height);
+    m_file.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(size));
+
+    m_head = 0;
+    m_tail = 0;
+    m_stop = false;
+    m_last_tick = 0;
+    m_last_click = sf::Vector2i(0, 0);
+    m_open = true;
+    m_thread = std::thread(&ReplayWriter::writer_loop, this);
+    return true;
+}
+
+bool ReplayWriter::is_open(void) const
+{
+    return m_open;
+}
+
+void ReplayWriter::record_click(std::uint32_t tick, const sf::Vector2i& pos)
+{
+    if (!m_open)
+        return;
+
+    // Координаты хранятся разностью с предыдущим кликом
+    std::uint8_t buffer[32];
+    std::size_t size = put_event(buffer, tick, c_event_click);
+    size += put_varint(buffer + size, zigzag(pos.x - m_last_click.x));
+    size += put_varint(buffer + size, zigzag(pos.y - m_last_click.y));
+    m_last_click = pos;
+    push(buffer, size);
+}
+
+void ReplayWriter::record_checksum(std::uint32_t tick, std::uint32_t checksum)
+{
+    if (!m_open)
+        return;
+
+    std::uint8_t buffer[16];
+    std::size_t size = put_event(buffer, tick, c_event_checksum);
+    size += put_u32(buffer + size, checksum);
+    push(buffer, size);
+}
+
+void ReplayWriter::finish(std::uint32_t tick)
+{
+    if (!m_open)
+        return;
+
+    std::uint8_t buffer[16];
+    std::size_t size = put_event(buffer, std::max(tick, m_last_tick), c_event_end);
+    push(buffer, size);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+
+    m_file.close();
+    m_open = false;
+}
+
+std::size_t ReplayWriter::get_stall_count(void) const
+{
+    return m_stalls;
+}
+
+std::size_t ReplayWriter::put_event(std::uint8_t* out, std::uint32_t tick, std::uint32_t type)
+{
+    // События идут по порядку, поэтому разность шагов неотрицательна и обычно мала
+    std::uint32_t delta = tick >= m_last_tick ? tick - m_last_tick : 0;
+    m_last_tick += delta;
+    return put_varint(out, (static_cast<std::uint64_t>(delta) << 2) | type);
+}
+
+void ReplayWriter::push(const std::uint8_t* data, std::size_t size)
+{
+    std::size_t capacity = m_ring.size();
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+
+    // Буфер переполнен: будим поток записи и ждем, пока он освободит место
+    if (capacity - (head - m_tail.load(std::memory_order_acquire)) < size)
+    {
+        ++m_stalls;
+        do
+        {
+            m_cv.notify_one();
+            std::this_thread::yield();
+        }
+        while (capacity - (head - m_tail.load(std::memory_order_acquire)) < size);
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+        m_ring[(head + i) & m_mask] = data[i];
+    m_head.store(head + size, std::memory_order_release);
+
+    // Заполнена половина буфера - не ждем очередного пробуждения потока записи
+    if (head + size - m_tail.load(std::memory_order_relaxed) > capacity / 2)
+        m_cv.notify_one();
+}
+
+void ReplayWriter::writer_loop(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        // Переносим данные в файл периодически или когда буфер заполнен наполовину
+        m_cv.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+            return m_stop || m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed) > m_ring.size() / 2;
+        });
+        bool stop = m_stop;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        // Флаг ставится после последнего события, поэтому оно уже записано
+        if (stop)
+            break;
+    }
+    m_file.flush();
+}
+
+void ReplayWriter::drain(void)
+{
+    std::size_t head = m_head.load(std::memory_order_acquire);
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    // Данные в буфере могут занимать два непрерывных куска
+    while (tail != head)
+    {
+        std::size_t begin = tail & m_mask;
+        std::size_t count = std::min(head - tail, m_ring.size() - begin);
+        m_file.write(reinterpret_cast<const char*>(m_ring.data() + begin), static_cast<std::streamsize>(count));
+        tail += count;
+    }
+    m_tail.store(tail, std::memory_order_release);
+}
+
+bool play_replay(const std::string& path, ReplayResult& result)
+{
+    result = ReplayResult();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Заголовок
+    ReplayReader reader(data);
+    ReplayHeader& header = result.header;
+    char magic[sizeof(c_magic)];
+    std::uint8_t version;
+    std::uint32_t tick_time;
+    if (!reader.get_bytes(magic, sizeof(magic)) || std::memcmp(magic, c_magic, sizeof(c_magic)) != 0 ||
+            !reader.get_bytes(&version, 1) || version != c_version ||
+            !reader.get_varint(header.seed) ||
+            !reader.get_varint32(tick_time) ||
+            !reader.get_varint32(header.checksum_interval) ||
+            !reader.get_float(header.game_board.left) ||
+            !reader.get_float(header.game_board.top) ||
+            !reader.get_float(header.game_board.width) ||
+            !reader.get_float(header.game_board.height))
+        return false;
+    header.tick_time = static_cast<std::int32_t>(tick_time);
+    if (header.tick_time <= 0)
+        return false;
+
+    MatchSimulation match(header.game_board, header.seed);
+
+    // Шаги идут по синтетическим часам: шаг с номером k выполняется в момент k * tick_time,
+    // как в игровом цикле с фиксированным шагом
+    auto advance = [&match, &header](std::uint32_t tick) {
+        while (match.get_tick() < tick)
+            match.update(static_cast<std::int32_t>(match.get_tick()) * header.tick_time);
+    };
+
+    std::uint32_t tick = 0;
+    sf::Vector2i click;
+    while (!reader.at_end())
+    {
+        std::uint64_t event;
+        if (!reader.get_varint(event))
+            return false;
+        tick += static_cast<std::uint32_t>(event >> 2);
+        advance(tick);
+
+        switch (static_cast<std::uint32_t>(event & 3))
+        {
+        case c_event_click:
+        {
+            std::uint32_t dx, dy;
+            if (!reader.get_varint32(dx) || !reader.get_varint32(dy))
+                return false;
+            click.x += unzigzag(dx);
+            click.y += unzigzag(dy);
+            match.click(sf::Vector2f(static_cast<float>(click.x), static_cast<float>(click.y)));
+            ++result.clicks;
+            break;
+        }
+
+        case c_event_checksum:
+        {
+            std::uint32_t checksum;
+            if (!reader.get_u32(checksum))
+                return false;
+            ++result.checked;
+            if (checksum != match.get_checksum())
+            {
+                if (result.mismatches == 0)
+                    result.first_mismatch_tick = tick;
+                ++result.mismatches;
+            }
+            break;
+        }
+
+        case c_event_end:
+            result.finished = true;
+            break;
+
+        default:
+            return false;
+        }
+
+        if (result.finished)
+            break;
+    }
+
+    result.ticks = match.get_tick();
+    result.cash = match.get_cash();
+    return true;
+}
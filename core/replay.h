@@ -0,0 +1,170 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Параметры записанного матча (заголовок файла повтора).
+ *
+ * Матч полностью определяется начальным значением генератора, длительностью
+ * шага и кликами игрока, поэтому кроме них в файле хранятся только
+ * контрольные суммы состояния для проверки воспроизведения.
+ */
+struct ReplayHeader
+{
+    std::uint64_t seed = 0;                ///< Начальное значение генератора случайных чисел матча.
+    std::int32_t tick_time = 10;           ///< Длительность шага симуляции в миллисекундах.
+    std::uint32_t checksum_interval = 1;   ///< Контрольная сумма записывается каждые checksum_interval шагов.
+    sf::FloatRect game_board{0, 0, 402, 712}; ///< Игровое поле.
+};
+
+/**
+ * @brief Результат воспроизведения повтора.
+ */
+struct ReplayResult
+{
+    ReplayHeader header;                 ///< Заголовок повтора.
+    bool finished = false;               ///< Найдена запись о конце матча.
+    std::uint32_t ticks = 0;             ///< Количество выполненных шагов симуляции.
+    std::size_t clicks = 0;              ///< Количество воспроизведенных кликов.
+    std::size_t checked = 0;             ///< Количество проверенных контрольных сумм.
+    std::size_t mismatches = 0;          ///< Количество несовпавших контрольных сумм.
+    std::uint32_t first_mismatch_tick = 0; ///< Шаг первого несовпадения (0 - несовпадений нет).
+    int cash = 0;                        ///< Итоговый счет.
+};
+
+/**
+ * @brief Запись матча в компактный двоичный файл.
+ *
+ * Каждое событие кодируется числами переменной длины (varint): разность
+ * шагов с предыдущим событием и тип события, для кликов - разность
+ * координат с предыдущим кликом. Закодированные события складываются
+ * в заранее выделенный кольцевой буфер, а в файл их переносит отдельный
+ * поток, поэтому запись во время игры не выделяет память и не ждет диска.
+ */
+class ReplayWriter
+{
+public:
+    /**
+     * @brief Конструктор с указанием размера кольцевого буфера.
+     * @param capacity Размер буфера в байтах (округляется вверх до степени двойки).
+     */
+    explicit ReplayWriter(std::size_t capacity = 1 << 16);
+
+    /**
+     * @brief Деструктор: завершает запись, если она не была завершена.
+     */
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    /**
+     * @brief Открывает файл, записывает заголовок и запускает поток записи.
+     * @param path Путь к файлу повтора.
+     * @param header Параметры матча.
+     * @return True, если файл удалось открыть, false в противном случае.
+     */
+    bool open(const std::string& path, const ReplayHeader& header);
+
+    /**
+     * @brief Проверяет, идет ли запись.
+     * @return True, если файл открыт и запись не завершена.
+     */
+    bool is_open(void) const;
+
+    /**
+     * @brief Записывает клик игрока.
+     * @param tick Количество шагов симуляции, выполненных до клика.
+     * @param pos Позиция клика в пикселях.
+     */
+    void record_click(std::uint32_t tick, const sf::Vector2i& pos);
+
+    /**
+     * @brief Записывает контрольную сумму состояния матча.
+     * @param tick Шаг симуляции, после которого посчитана сумма.
+     * @param checksum Контрольная сумма.
+     */
+    void record_checksum(std::uint32_t tick, std::uint32_t checksum);
+
+    /**
+     * @brief Записывает конец матча, дописывает буфер в файл и закрывает его.
+     * @param tick Количество шагов симуляции за матч.
+     */
+    void finish(std::uint32_t tick);
+
+    /**
+     * @brief Количество ожиданий свободного места в буфере.
+     * @return Сколько раз запись событий ждала поток записи (0 - буфер ни разу не переполнялся).
+     */
+    std::size_t get_stall_count(void) const;
+
+private:
+    /**
+     * @brief Кодирует начало события: разность шагов и тип события.
+     * @param out Буфер для закодированных байт.
+     * @param tick Шаг события.
+     * @param type Тип события.
+     * @return Количество записанных байт.
+     */
+    std::size_t put_event(std::uint8_t* out, std::uint32_t tick, std::uint32_t type);
+
+    /**
+     * @brief Копирует закодированное событие в кольцевой буфер.
+     * @param data Закодированные байты.
+     * @param size Количество байт.
+     */
+    void push(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Основной цикл потока записи.
+     */
+    void writer_loop(void);
+
+    /**
+     * @brief Переносит накопленные байты из буфера в файл.
+     */
+    void drain(void);
+
+    std::vector<std::uint8_t> m_ring; ///< Кольцевой буфер закодированных событий.
+    std::size_t m_mask = 0;           ///< Маска индекса в буфере (размер - 1).
+    std::atomic<std::size_t> m_head{0}; ///< Позиция записи (меняет только игровой поток).
+    std::atomic<std::size_t> m_tail{0}; ///< Позиция чтения (меняет только поток записи).
+
+    std::ofstream m_file;              ///< Файл повтора.
+    std::thread m_thread;              ///< Поток записи.
+    std::mutex m_mutex;                ///< Защищает ожидание потока записи.
+    std::condition_variable m_cv;      ///< Сигнал о заполнении буфера или остановке.
+    bool m_stop = false;               ///< Флаг остановки потока записи (под m_mutex).
+    bool m_open = false;               ///< Флаг идущей записи.
+
+    std::uint32_t m_last_tick = 0;     ///< Шаг предыдущего события.
+    sf::Vector2i m_last_click;         ///< Позиция предыдущего клика.
+    std::size_t m_stalls = 0;          ///< Количество ожиданий свободного места.
+};
+
+/**
+ * @brief Воспроизводит записанный матч без графики.
+ *
+ * Матч создается с записанным начальным значением и обновляется по
+ * синтетическим часам (без ожидания реального времени), клики подаются
+ * на тех же шагах, что и при записи, а записанные контрольные суммы
+ * сравниваются с контрольными суммами воспроизведения.
+ *
+ * @param path Путь к файлу повтора.
+ * @param result Результат воспроизведения.
+ * @return True, если файл прочитан и разобран, false, если он не открывается или поврежден.
+ */
+bool play_replay(const std::string& path, ReplayResult& result);
+
+#endif // REPLAY_H
@@ -0,0 +1,99 @@
+#include "spatialgrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+SpatialGrid::SpatialGrid(const sf::FloatRect& area, float cell_size)
+    : m_area(area),
+      m_cell_size(cell_size)
+{
+    if (m_cell_size <= 0.f)
+        throw std::runtime_error("Incorrect grid cell size");
+
+    m_cols = std::max(1, static_cast<int>(std::ceil(area.width / cell_size)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(area.height / cell_size)));
+
+    std::size_t cells = static_cast<std::size_t>(m_cols) * m_rows;
+    m_offsets.assign(cells + 1, 0);
+    m_cursor.assign(cells, 0);
+}
+
+void SpatialGrid::reserve(std::size_t capacity)
+{
+    m_items.reserve(capacity * 4);
+}
+
+void SpatialGrid::rebuild(const EntityStore& store)
+{
+    if (m_offsets.empty()) // Сетка не задана
+        return;
+
+    std::size_t n = store.size();
+    std::fill(m_offsets.begin(), m_offsets.end(), 0);
+
+    // Первый проход: считаем количество сущностей в каждой ячейке
+    int x0, y0, x1, y1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!cell_range(store.get_rect(i), x0, y0, x1, y1))
+            continue;
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                ++m_offsets[y * m_cols + x + 1];
+    }
+
+    // Префиксные суммы дают начало списка каждой ячейки
+    for (std::size_t c = 1; c < m_offsets.size(); ++c)
+        m_offsets[c] += m_offsets[c - 1];
+
+    m_items.resize(m_offsets.back());
+    std::copy(m_offsets.begin(), m_offsets.end() - 1, m_cursor.begin());
+
+    // Второй проход: раскладываем индексы по ячейкам (по возрастанию)
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!cell_range(store.get_rect(i), x0, y0, x1, y1))
+            continue;
+
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                m_items[m_cursor[y * m_cols + x]++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+SpatialGrid::Cell SpatialGrid::query(const sf::Vector2f& pos) const
+{
+    Cell cell;
+    if (m_items.empty())
+        return cell;
+
+    int x = static_cast<int>(std::floor((pos.x - m_area.left) / m_cell_size));
+    int y = static_cast<int>(std::floor((pos.y - m_area.top) / m_cell_size));
+    if (x < 0 || y < 0 || x >= m_cols || y >= m_rows) // Точка вне сетки
+        return cell;
+
+    std::size_t c = static_cast<std::size_t>(y) * m_cols + x;
+    cell.first = m_items.data() + m_offsets[c];
+    cell.last = m_items.data() + m_offsets[c + 1];
+    return cell;
+}
+
+bool SpatialGrid::cell_range(const sf::FloatRect& rect, int& x0, int& y0, int& x1, int& y1) const
+{
+    x0 = static_cast<int>(std::floor((rect.left - m_area.left) / m_cell_size));
+    y0 = static_cast<int>(std::floor((rect.top - m_area.top) / m_cell_size));
+    x1 = static_cast<int>(std::floor((rect.left + rect.width - m_area.left) / m_cell_size));
+    y1 = static_cast<int>(std::floor((rect.top + rect.height - m_area.top) / m_cell_size));
+
+    if (x1 < 0 || y1 < 0 || x0 >= m_cols || y0 >= m_rows) // Целиком вне сетки
+        return false;
+
+    // Обрезаем диапазон по границам сетки
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, m_cols - 1);
+    y1 = std::min(y1, m_rows - 1);
+    return true;
+}
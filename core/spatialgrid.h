@@ -0,0 +1,106 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "entitystore.h"
+
+/**
+ * @brief Равномерная сетка для быстрого поиска сущностей по точке.
+ *
+ * Область делится на квадратные ячейки, и для каждой ячейки хранится список
+ * плотных индексов сущностей EntityStore, которые ее пересекают. Списки
+ * лежат в одном массиве (сортировка подсчетом), внутри ячейки индексы
+ * идут по возрастанию, то есть в порядке отрисовки.
+ * После любого изменения хранилища сетку нужно перестроить.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * @brief Диапазон индексов сущностей одной ячейки.
+     */
+    struct Cell
+    {
+        const std::uint32_t* first = nullptr; ///< Начало диапазона.
+        const std::uint32_t* last = nullptr;  ///< Конец диапазона.
+
+        /**
+         * @brief Начало диапазона (для range-based for).
+         * @return Указатель на первый индекс.
+         */
+        const std::uint32_t* begin(void) const { return first; }
+
+        /**
+         * @brief Конец диапазона (для range-based for).
+         * @return Указатель за последним индексом.
+         */
+        const std::uint32_t* end(void) const { return last; }
+
+        /**
+         * @brief Количество сущностей в ячейке.
+         * @return Количество индексов в диапазоне.
+         */
+        std::size_t size(void) const { return static_cast<std::size_t>(last - first); }
+    };
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    explicit SpatialGrid(void) = default;
+
+    /**
+     * @brief Конструктор с указанием области и размера ячейки.
+     * @param area Область, покрываемая сеткой.
+     * @param cell_size Сторона ячейки (лучше не меньше размера сущностей).
+     * @throw std::runtime_error при неположительном размере ячейки.
+     */
+    explicit SpatialGrid(const sf::FloatRect& area, float cell_size);
+
+    /**
+     * @brief Резервирует память под заданное количество сущностей.
+     *
+     * Сущность не больше ячейки попадает не более чем в четыре ячейки.
+     *
+     * @param capacity Ожидаемое количество сущностей.
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Перестраивает сетку по текущему состоянию хранилища.
+     * @param store Хранилище сущностей.
+     */
+    void rebuild(const EntityStore& store);
+
+    /**
+     * @brief Возвращает сущности ячейки, в которую попадает точка.
+     * @param pos Точка.
+     * @return Диапазон плотных индексов (пустой, если точка вне сетки).
+     */
+    Cell query(const sf::Vector2f& pos) const;
+
+private:
+    /**
+     * @brief Вычисляет диапазон ячеек, которые пересекает прямоугольник.
+     * @param rect Прямоугольник.
+     * @param x0 Первый столбец.
+     * @param y0 Первая строка.
+     * @param x1 Последний столбец.
+     * @param y1 Последняя строка.
+     * @return false, если прямоугольник целиком вне сетки, иначе true.
+     */
+    bool cell_range(const sf::FloatRect& rect, int& x0, int& y0, int& x1, int& y1) const;
+
+    sf::FloatRect m_area;                 ///< Область, покрываемая сеткой.
+    float m_cell_size = 1.f;              ///< Сторона ячейки.
+    int m_cols = 0;                       ///< Количество столбцов.
+    int m_rows = 0;                       ///< Количество строк.
+    std::vector<std::uint32_t> m_offsets; ///< Начало списка каждой ячейки в m_items (cols * rows + 1).
+    std::vector<std::uint32_t> m_cursor;  ///< Позиции записи при заполнении ячеек.
+    std::vector<std::uint32_t> m_items;   ///< Индексы сущностей всех ячеек подряд.
+};
+
+#endif // SPATIALGRID_H
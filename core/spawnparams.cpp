@@ -0,0 +1,30 @@
+#include "spawnparams.h"
+
+SpawnParams make_spawn_params(const sf::FloatRect& game_board, MatchRandom& random)
+{
+    SpawnParams params;
+    make_spawn_params(game_board, random, &params, 1);
+    return params;
+}
+
+void make_spawn_params(const sf::FloatRect& game_board, MatchRandom& random, SpawnParams* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        SpawnParams& params = out[i];
+        params.direction = sf::Vector2f(0.f, 1.f);  // Направление движения вниз
+
+        float size = random.uniform(c_spawn_min_size, c_spawn_max_size);
+        params.size = sf::Vector2f(size, size);
+
+        // Генерация случайной позиции по оси X в пределах игрового поля
+        float from = game_board.left;
+        float to = game_board.left + game_board.width - size;
+        float pos_x = random.uniform(from, to);
+        // Позиция по оси Y выше верхней границы игрового поля
+        float pos_y = game_board.top - size;
+        params.position = sf::Vector2f(pos_x, pos_y);
+
+        params.speed = random.uniform(150.f, 200.f);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SPAWNPARAMS_H
+#define SPAWNPARAMS_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+#include "matchrandom.h"
+
+constexpr float c_spawn_min_size = 26.f; ///< Наименьший размер нового объекта.
+constexpr float c_spawn_max_size = 45.f; ///< Наибольший размер нового объекта.
+
+/**
+ * @brief Параметры появления нового объекта на игровом поле.
+ */
+struct SpawnParams
+{
+    sf::Vector2f position;  ///< Начальная позиция (левый верхний угол).
+    sf::Vector2f size;      ///< Размер объекта.
+    sf::Vector2f direction; ///< Направление движения.
+    float speed = 0.f;      ///< Скорость движения.
+};
+
+/**
+ * @brief Генерирует случайные параметры появления объекта над игровым полем.
+ *
+ * @param game_board Прямоугольник, представляющий игровое поле.
+ * @param random Генератор случайных чисел матча.
+ * @return Параметры появления объекта.
+ */
+SpawnParams make_spawn_params(const sf::FloatRect& game_board, MatchRandom& random);
+
+/**
+ * @brief Генерирует параметры появления сразу для нескольких объектов.
+ *
+ * Дает ту же последовательность, что и count вызовов make_spawn_params.
+ *
+ * @param game_board Прямоугольник, представляющий игровое поле.
+ * @param random Генератор случайных чисел матча.
+ * @param out Массив для результата (не меньше count элементов).
+ * @param count Количество объектов.
+ */
+void make_spawn_params(const sf::FloatRect& game_board, MatchRandom& random, SpawnParams* out, std::size_t count);
+
+#endif // SPAWNPARAMS_H
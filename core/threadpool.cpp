@@ -0,0 +1,143 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Пул и номер потока пула, в котором выполняется код (nullptr вне пула)
+    thread_local const void* t_pool = nullptr;
+    thread_local std::size_t t_index = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    m_workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+
+    m_threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        m_threads.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_task_cv.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    // Задачи из потока пула кладем в его же очередь, остальные - по кругу
+    std::size_t index;
+    if (t_pool == this)
+        index = t_index;
+    else
+        index = m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    ++m_pending;
+    {
+        std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+        m_workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_queued;
+    }
+    m_task_cv.notify_one();
+}
+
+void ThreadPool::wait(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this]() { return m_pending == 0; });
+}
+
+std::size_t ThreadPool::get_thread_count(void) const
+{
+    return m_threads.size();
+}
+
+std::size_t ThreadPool::get_steal_count(void) const
+{
+    return m_steals;
+}
+
+void ThreadPool::worker_loop(std::size_t index)
+{
+    t_pool = this;
+    t_index = index;
+
+    std::function<void()> task;
+    while (true)
+    {
+        {
+            // Ждем появления задач в любой из очередей
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_task_cv.wait(lock, [this]() { return m_stop || m_queued > 0; });
+            if (m_stop && m_queued == 0)
+                return;
+        }
+
+        // Задачу мог забрать другой поток, тогда просто ждем снова
+        if (!pop_task(index, task))
+            continue;
+
+        task();
+        task = nullptr;
+
+        if (--m_pending == 0) // Выполнена последняя задача
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done_cv.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::pop_task(std::size_t index, std::function<void()>& task)
+{
+    bool found = false;
+
+    // Сначала своя очередь (с конца: последние задачи еще в кэше)
+    {
+        Worker& own = *m_workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Затем перехватываем самую старую задачу у других потоков
+    for (std::size_t i = 1; !found && i < m_workers.size(); ++i)
+    {
+        Worker& victim = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+            ++m_steals;
+        }
+    }
+
+    if (found)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_queued;
+    }
+    return found;
+}
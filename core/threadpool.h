@@ -0,0 +1,103 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Пул потоков с перехватом задач (work stealing).
+ *
+ * У каждого потока своя очередь задач: поток берет задачи с конца своей
+ * очереди, а когда она пуста, забирает задачи с начала очередей других
+ * потоков. Поэтому длинные и короткие задачи сами распределяются по потокам.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Конструктор, запускающий потоки.
+     * @param threads Количество потоков (0 - по числу ядер процессора).
+     */
+    explicit ThreadPool(std::size_t threads);
+
+    /**
+     * @brief Деструктор: дожидается выполнения всех задач и останавливает потоки.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Добавляет задачу в пул.
+     *
+     * Задача, добавленная из потока пула, попадает в очередь этого потока,
+     * иначе очереди выбираются по кругу.
+     *
+     * @param task Задача.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Ждет, пока не будут выполнены все добавленные задачи.
+     */
+    void wait(void);
+
+    /**
+     * @brief Количество потоков пула.
+     * @return Количество потоков.
+     */
+    std::size_t get_thread_count(void) const;
+
+    /**
+     * @brief Количество задач, перехваченных у других потоков.
+     * @return Количество перехваченных задач с момента создания пула.
+     */
+    std::size_t get_steal_count(void) const;
+
+private:
+    /**
+     * @brief Очередь задач одного потока.
+     */
+    struct Worker
+    {
+        std::mutex mutex;                        ///< Защищает очередь.
+        std::deque<std::function<void()>> tasks; ///< Задачи потока.
+    };
+
+    /**
+     * @brief Основной цикл потока пула.
+     * @param index Номер потока.
+     */
+    void worker_loop(std::size_t index);
+
+    /**
+     * @brief Берет задачу из своей очереди или перехватывает у других потоков.
+     * @param index Номер потока.
+     * @param task Полученная задача.
+     * @return true, если задача получена, иначе false.
+     */
+    bool pop_task(std::size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers; ///< Очереди задач потоков.
+    std::vector<std::thread> m_threads;             ///< Потоки пула.
+
+    std::mutex m_mutex;                   ///< Защищает ожидание задач и их завершения.
+    std::condition_variable m_task_cv;    ///< Сигнал о появлении задач или остановке.
+    std::condition_variable m_done_cv;    ///< Сигнал о выполнении всех задач.
+    std::size_t m_queued = 0;             ///< Количество задач в очередях (под m_mutex).
+    bool m_stop = false;                  ///< Флаг остановки потоков (под m_mutex).
+
+    std::atomic<std::size_t> m_pending{0}; ///< Количество добавленных, но не выполненных задач.
+    std::atomic<std::size_t> m_next{0};    ///< Следующая очередь для задач извне пула.
+    std::atomic<std::size_t> m_steals{0};  ///< Количество перехваченных задач.
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,41 @@
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "gamerenderer.h"
+
+/**
+ * @brief Сборка пака ресурсов игры.
+ *
+ * Запускается из каталога app (пути к ресурсам относительные): читает все
+ * картинки и шрифты так же, как игра при запуске, раскладывает их по
+ * страницам атласа и сохраняет страницы (пиксели RGBA), кадры полос и
+ * размеры символов шрифтов в один файл. Игра отображает этот файл в
+ * память и загружает страницы в видеопамять без декодирования картинок.
+ *
+ * Использование: packer [файл пака] (по умолчанию GameRenderer::mc_pack_path).
+ * Пак нужно пересобирать после изменения картинок в app/src.
+ */
+int main(int argc, char** argv)
+{
+    std::string pack_path = argc > 1 ? argv[1] : GameRenderer::mc_pack_path;
+
+    auto start = std::chrono::steady_clock::now();
+    bool success = GameRenderer::bake_resources(pack_path);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Размер пака для отчета
+    std::ifstream pack(pack_path, std::ios::binary | std::ios::ate);
+    long long pack_size = pack ? static_cast<long long>(pack.tellg()) : 0;
+
+    std::cout << pack_path << ": " << GameRenderer::get_decoded_images() << " images, " << pack_size / 1024
+              << " KB, " << elapsed << " ms" << std::endl;
+    if (!success)
+    {
+        std::cerr << "error: not all resources were packed (run from the app directory)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TARGET = packer
+
+SOURCES +=  \
+    ../app/alloccounter.cpp \
+    ../app/animation.cpp \
+    ../app/animationscheduler.cpp \
+    ../app/assetpack.cpp \
+    ../app/framegeometry.cpp \
+    ../app/gamelabels.cpp \
+    ../app/gameobjects.cpp \
+    ../app/glyphfont.cpp \
+    ../app/gamerenderer.cpp \
+    ../app/label.cpp \
+    ../app/number.cpp \
+    ../app/object.cpp \
+    ../app/spritebatch.cpp \
+    ../app/textureatlas.cpp \
+    ../app/vertexstream.cpp \
+    main.cpp
+
+HEADERS +=  \
+    ../app/alloccounter.h \
+    ../app/animation.h \
+    ../app/animationscheduler.h \
+    ../app/assetpack.h \
+    ../app/framegeometry.h \
+    ../app/gamelabels.h \
+    ../app/gameobjects.h \
+    ../app/glyphfont.h \
+    ../app/gamerenderer.h \
+    ../app/label.h \
+    ../app/number.h \
+    ../app/object.h \
+    ../app/objectpool.h \
+    ../app/spritebatch.h \
+    ../app/textureatlas.h \
+    ../app/vertexstream.h
+
+INCLUDEPATH += ../app ../core
+LIBS += -L../core -lblumcore
+PRE_TARGETDEPS += ../core/libblumcore.a
+
+# Пак собирается из тех же исходников, что и игра
+QMAKE_CXXFLAGS += -Wall -Wextra -Werror -O2
+
+# путь к заголовочным файлам SFML
+INCLUDEPATH += /usr/include
+
+# сами библиотеки SFML
+LIBS += -lsfml-graphics -lsfml-window -lsfml-system
@@ -0,0 +1,283 @@
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "matchrandom.h"
+#include "matchsimulation.h"
+#include "replay.h"
+#include "threadpool.h"
+
+namespace
+{
+    /**
+     * @brief Результат одного сыгранного матча.
+     */
+    struct MatchResult
+    {
+        std::size_t ticks = 0; ///< Количество шагов симуляции.
+        int cash = 0;          ///< Итоговый счет.
+        std::size_t hits = 0;  ///< Количество нажатых объектов.
+    };
+
+    /**
+     * @brief Начальное значение генератора для матча (splitmix32).
+     *
+     * Соседние номера матчей дают независимые потоки случайных чисел.
+     *
+     * @param base Общее начальное значение запуска.
+     * @param index Номер матча.
+     * @return Начальное значение генератора матча.
+     */
+    std::uint32_t match_seed(std::uint32_t base, std::size_t index)
+    {
+        std::uint32_t x = base + static_cast<std::uint32_t>(index) * 0x9E3779B9u;
+        x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+        x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+        return x ^ (x >> 16);
+    }
+
+    /**
+     * @brief Играет один матч по синтетическим часам.
+     *
+     * Время идет шагами tick_time, а игрок с вероятностью 1/10 за шаг
+     * нажимает на случайный объект поля. Игрок использует отдельную
+     * последовательность генератора, поэтому результат зависит только
+     * от начального значения.
+     *
+     * @param seed Начальное значение генератора матча.
+     * @param tick_time Длительность шага симуляции в миллисекундах.
+     * @return Результат матча.
+     */
+    MatchResult play_match(std::uint32_t seed, int32_t tick_time)
+    {
+        sf::FloatRect game_board(0, 0, 402, 712);
+        MatchSimulation match(game_board, seed);
+        // Старшие биты начального значения выбирают другую последовательность PCG32
+        MatchRandom player((std::uint64_t(1) << 32) | seed);
+
+        MatchResult result;
+        int32_t cur_time = 0;
+        while (!match.is_game_over())
+        {
+            match.update(cur_time);
+            ++result.ticks;
+            cur_time += tick_time;
+
+            const EntityStore& entities = match.get_entities();
+            if (player.below(10) != 0 || entities.empty())
+                continue;
+
+            // Нажимаем в центр случайного объекта
+            sf::FloatRect rect = entities.get_rect(player.below(static_cast<std::uint32_t>(entities.size())));
+            match.click(sf::Vector2f(rect.left + rect.width / 2.f, rect.top + rect.height / 2.f));
+        }
+
+        const auto& statistics = match.get_statistics();
+        result.cash = match.get_cash();
+        result.hits = statistics.at("blum") + statistics.at("ice") + statistics.at("bomb");
+        return result;
+    }
+
+    /**
+     * @brief Играет все матчи на пуле из заданного количества потоков.
+     * @param threads Количество потоков.
+     * @param matches Количество матчей.
+     * @param seed Общее начальное значение запуска.
+     * @param tick_time Длительность шага симуляции в миллисекундах.
+     * @param baseline Время на одном потоке в секундах (0 - еще не измерено).
+     * @return Время выполнения в секундах.
+     */
+    double run(std::size_t threads, std::size_t matches, std::uint32_t seed, int32_t tick_time, double baseline)
+    {
+        std::vector<MatchResult> results(matches);
+
+        auto start = std::chrono::steady_clock::now();
+        ThreadPool pool(threads);
+        for (std::size_t i = 0; i < matches; ++i)
+        {
+            pool.submit([&results, i, seed, tick_time]() {
+                results[i] = play_match(match_seed(seed, i), tick_time);
+            });
+        }
+        pool.wait();
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        // Контрольная сумма не зависит от количества потоков,
+        // если матчи действительно независимы и детерминированы
+        std::size_t ticks = 0;
+        std::uint64_t checksum = 1469598103934665603ull;
+        for (const MatchResult& result : results)
+        {
+            ticks += result.ticks;
+            checksum = (checksum ^ static_cast<std::uint64_t>(result.cash)) * 1099511628211ull;
+            checksum = (checksum ^ result.hits) * 1099511628211ull;
+        }
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(12) << matches / seconds
+                  << std::setw(14) << ticks / seconds
+                  << std::setprecision(2) << std::setw(9) << (baseline > 0.0 ? baseline / seconds : 1.0)
+                  << std::setw(9) << pool.get_steal_count()
+                  << "  " << std::hex << checksum << std::dec << std::endl;
+        return seconds;
+    }
+
+    /**
+     * @brief Воспроизводит записанный матч и сверяет контрольные суммы.
+     * @param path Путь к файлу повтора.
+     * @return Код завершения программы: 0, если матч воспроизведен без расхождений.
+     */
+    int play(const std::string& path)
+    {
+        ReplayResult result;
+        auto start = std::chrono::steady_clock::now();
+        bool parsed = play_replay(path, result);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        if (!parsed)
+        {
+            std::cout << "cannot read replay " << path << std::endl;
+            return 1;
+        }
+
+        // Во сколько раз воспроизведение быстрее реального времени матча
+        double match_seconds = static_cast<double>(result.ticks) * result.header.tick_time / 1000.0;
+        std::cout << "replay " << path << ": seed " << result.header.seed
+                  << ", tick " << result.header.tick_time << " ms" << std::endl;
+        std::cout << result.ticks << " ticks, " << result.clicks << " clicks, cash " << result.cash
+                  << std::fixed << std::setprecision(1)
+                  << ", " << seconds * 1000.0 << " ms (x" << match_seconds / std::max(seconds, 1e-9) << " real time)" << std::endl;
+        std::cout << result.checked << " checksums, " << result.mismatches << " mismatches";
+        if (result.mismatches > 0)
+            std::cout << " (first at tick " << result.first_mismatch_tick << ")";
+        if (!result.finished)
+            std::cout << ", replay is truncated";
+        std::cout << std::endl;
+
+        return result.finished && result.mismatches == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Печатает подсказку по аргументам командной строки.
+     * @param program Имя программы.
+     */
+    void print_usage(const char* program)
+    {
+        std::cerr << "usage: " << program << " [matches [max_threads [seed [tick_ms]]]]" << std::endl
+                  << "       " << program << " --play <file>" << std::endl;
+    }
+
+    /**
+     * @brief Разбирает неотрицательное целое число из аргумента.
+     *
+     * Число должно занимать аргумент целиком. Знак не допускается:
+     * strtoull молча превращает "-1" в огромное значение.
+     *
+     * @param text Текст аргумента.
+     * @param min Наименьшее допустимое значение.
+     * @param max Наибольшее допустимое значение.
+     * @param value Результат (не меняется при ошибке).
+     * @return true, если число корректно и лежит в диапазоне, иначе false.
+     */
+    bool parse_number(const char* text, unsigned long long min, unsigned long long max, unsigned long long& value)
+    {
+        if (!std::isdigit(static_cast<unsigned char>(text[0])))
+            return false;
+
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed < min || parsed > max)
+            return false;
+
+        value = parsed;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // "--play <файл>" воспроизводит записанный матч
+    if (argc > 1 && std::string(argv[1]) == "--play")
+    {
+        if (argc != 3)
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return play(argv[2]);
+    }
+
+    // Параметры: количество матчей, максимум потоков, начальное значение, шаг в мс
+    std::size_t matches = 2000;
+    std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::uint32_t seed = 1;
+    int32_t tick_time = 10;
+    if (argc > 5)
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    unsigned long long value = 0;
+    bool valid = true;
+    if (argc > 1)
+    {
+        valid = valid && parse_number(argv[1], 1, 100000000, value);
+        matches = static_cast<std::size_t>(value);
+    }
+    if (argc > 2)
+    {
+        valid = valid && parse_number(argv[2], 1, 1024, value);
+        max_threads = static_cast<std::size_t>(value);
+    }
+    if (argc > 3)
+    {
+        valid = valid && parse_number(argv[3], 0, 0xFFFFFFFFull, value);
+        seed = static_cast<std::uint32_t>(value);
+    }
+    if (argc > 4)
+    {
+        valid = valid && parse_number(argv[4], 1, 1000, value);
+        tick_time = static_cast<int32_t>(value);
+    }
+    if (!valid)
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Шаг, как и частота в игре, должен делить секунду нацело
+    if (1000 % tick_time != 0)
+    {
+        std::cerr << "tick " << tick_time << " ms does not divide 1000 (e.g. 1, 2, 4, 5, 8, 10, 20)" << std::endl;
+        return 1;
+    }
+
+    std::cout << matches << " matches, tick " << tick_time << " ms, seed " << seed << std::endl;
+    std::cout << "threads   matches/s       ticks/s  speedup   steals  checksum" << std::endl;
+
+    // Потоки: 1, 2, 4, ... и максимум
+    double baseline = 0.0;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        double seconds = run(threads, matches, seed, tick_time, baseline);
+        if (threads == 1)
+            baseline = seconds;
+        if (threads < max_threads && threads * 2 > max_threads)
+            run(max_threads, matches, seed, tick_time, baseline);
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TARGET = runner
+
+SOURCES +=  \
+    main.cpp
+
+# Матчи играются без графики, достаточно библиотеки симуляции
+INCLUDEPATH += ../core
+LIBS += -L../core -lblumcore
+PRE_TARGETDEPS += ../core/libblumcore.a
+
+# Замеры имеют смысл только с оптимизацией
+QMAKE_CXXFLAGS += -Wall -Wextra -Werror -O2
+
+# путь к заголовочным файлам SFML (только sf::Rect и sf::Vector2)
+INCLUDEPATH += /usr/include
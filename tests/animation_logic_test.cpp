@@ -20,7 +20,8 @@ BOOST_AUTO_TEST_CASE(LoopingAnimation) {
 
     BOOST_CHECK_EQUAL(anim.get_current_sprite_index(0), 0);    ///< Начальный индекс
     BOOST_CHECK_EQUAL(anim.get_current_sprite_index(50), 1);   ///< Первая смена спрайта
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(150), 0);  ///< Возвращение к началу после цикла
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(100), 0);  ///< Возвращение к началу после цикла
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(150), 1);  ///< Второй цикл
 }
 
 /**
@@ -66,9 +67,10 @@ BOOST_AUTO_TEST_CASE(StopAnimation) {
 
     BOOST_CHECK_EQUAL(anim.get_current_sprite_index(0), 0);  ///< Запускаем анимацию
 
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(200), 1);  ///< Достигаем конца анимации
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(100), 1);  ///< Достигаем конца анимации
+    BOOST_CHECK(anim.is_end(200));                             ///< Все кадры показаны
 
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(300), 0);  ///< Проверяем, что попали в начало
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(200), 0);  ///< Проверяем, что попали в начало
 }
 
 /**
@@ -78,9 +80,99 @@ BOOST_AUTO_TEST_CASE(RestartAnimationAfterStop) {
     AnimationLogic anim(2, 100);
 
     BOOST_CHECK_EQUAL(anim.get_current_sprite_index(0), 0);    ///< Начальный индекс
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(200), 1);  ///< Достигаем конца анимации
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(300), 0);  ///< Проверяем возвращение к началу
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(100), 1);  ///< Достигаем конца анимации
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(200), 0);  ///< Проверяем возвращение к началу
 
     anim.start();  ///< Запускаем анимацию снова
-    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(400), 0);  ///< Проверяем первую смену спрайта после запуска
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(400), 0);  ///< Анимация началась заново
+    BOOST_CHECK(!anim.is_end(400));
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(500), 1);  ///< Проверяем первую смену спрайта после запуска
+}
+
+/**
+ * @brief Тест кадров анимации: кадр берется из атласа без копирования спрайта.
+ */
+BOOST_AUTO_TEST_CASE(AnimationFrames) {
+    std::vector<AtlasFrame> frames(3);
+    for (int i = 0; i < 3; ++i)
+        frames[i].rect = sf::IntRect(i * 20, 0, 20, 10);
+
+    Animation anim(frames, 100);
+    BOOST_CHECK(anim.get_size() == sf::Vector2f(20.f, 10.f));   ///< По умолчанию размер кадра в атласе
+
+    BOOST_CHECK(anim.get_frame(0).rect == frames[0].rect);      ///< Первый кадр
+    BOOST_CHECK(anim.get_frame(100).rect == frames[1].rect);    ///< Смена кадра
+    BOOST_CHECK(anim.get_frame(150).texture == nullptr);        ///< Незагруженный кадр остается пустым
+
+    anim.resize(sf::Vector2f(40.f, 40.f));
+    BOOST_CHECK(anim.get_size() == sf::Vector2f(40.f, 40.f));   ///< Новый размер на экране
+    BOOST_CHECK(anim.get_frame(200).rect == frames[2].rect);    ///< Прямоугольник в атласе не меняется
+}
+
+/**
+ * @brief Тест общей таблицы кадров: анимации одного типа не копируют кадры.
+ */
+BOOST_AUTO_TEST_CASE(AnimationSharedFrames) {
+    std::vector<AtlasFrame> frames(2);
+    frames[1].rect = sf::IntRect(10, 0, 10, 10);
+
+    Animation first(frames, 100);
+    Animation second(frames, 100);
+    second.resize(sf::Vector2f(5.f, 5.f));
+
+    BOOST_CHECK(&first.get_frame(0) == &frames[0]);     ///< Кадр берется прямо из таблицы
+    BOOST_CHECK(&second.get_frame(0) == &frames[0]);    ///< Обе анимации ссылаются на одну таблицу
+    BOOST_CHECK(&first.get_frame(100) == &frames[1]);   ///< Часы у каждой анимации свои
+    BOOST_CHECK(&second.get_frame(50) == &frames[0]);
+    BOOST_CHECK(first.get_size() == sf::Vector2f(0.f, 0.f));   ///< Размер у каждой анимации свой
+    BOOST_CHECK(second.get_size() == sf::Vector2f(5.f, 5.f));
+
+    frames[1].rect = sf::IntRect(20, 0, 10, 10);        ///< Таблица перестроена (например, новым атласом)
+    BOOST_CHECK(first.get_frame(100).rect == frames[1].rect);
+}
+
+/**
+ * @brief Тест долгого перерыва: кадры пропускаются, а не догоняются по одному.
+ */
+BOOST_AUTO_TEST_CASE(AnimationLongGap) {
+    AnimationLogic anim(5, 100);
+
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(0), 0);     ///< Начальный индекс
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(350), 3);   ///< Пропущены кадры 1 и 2
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(360), 3);   ///< Кадр не сменился раньше времени
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(1230), 2);  ///< Несколько циклов за один перерыв
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(1300), 3);  ///< Дальше анимация идет без отставания
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(100000), 0);
+}
+
+/**
+ * @brief Тест окончания анимации без промежуточных запросов кадра.
+ */
+BOOST_AUTO_TEST_CASE(AnimationEndWithoutDraw) {
+    AnimationLogic anim(3, 50);
+
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(1000), 0);  ///< Анимация началась
+    BOOST_CHECK(!anim.is_end(1149));  ///< Последний кадр еще показывается
+    BOOST_CHECK(anim.is_end(1150));   ///< Все кадры показаны, хотя их никто не запрашивал
+    BOOST_CHECK(anim.is_end(5000));   ///< После долгого перерыва анимация тоже закончилась
+    BOOST_CHECK(!anim.is_end(900));   ///< Время до начала считается началом
+}
+
+/**
+ * @brief Тест запуска анимации с известным временем начала.
+ */
+BOOST_AUTO_TEST_CASE(AnimationStartAtTime) {
+    AnimationLogic anim(4, 100);
+
+    BOOST_CHECK(!anim.is_end(100000));  ///< Не начатая анимация не заканчивается
+
+    anim.start(1000);  ///< Например, нажатие на объект вне экрана
+    BOOST_CHECK(!anim.is_end(1399));
+    BOOST_CHECK(anim.is_end(1400));
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(1250), 2);  ///< Первый запрос сразу дает верный кадр
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(990), 0);   ///< Кадр, нарисованный раньше начала
+
+    anim.start(2000);  ///< Перезапуск
+    BOOST_CHECK_EQUAL(anim.get_current_sprite_index(2100), 1);
+    BOOST_CHECK(!anim.is_end(2100));
 }
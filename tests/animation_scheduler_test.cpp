@@ -0,0 +1,93 @@
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+#include "animation.h"
+#include "animationscheduler.h"
+
+/**
+ * @brief Тест продвижения циклических и нециклических анимаций одним проходом.
+ */
+BOOST_AUTO_TEST_CASE(SchedulerAdvance) {
+    AnimationScheduler scheduler;
+    AnimationScheduler::Handle loop = scheduler.add(3, 100, true, 0);
+    AnimationScheduler::Handle once = scheduler.add(2, 50, false, 0);
+    AnimationScheduler::Handle stopped = scheduler.add(4, 10, false, -1);
+    BOOST_CHECK_EQUAL(scheduler.size(), 3u);
+
+    scheduler.advance(60);
+    BOOST_CHECK_EQUAL(scheduler.get_frame(loop), 0u);
+    BOOST_CHECK_EQUAL(scheduler.get_frame(once), 1u);
+    BOOST_CHECK_EQUAL(scheduler.get_frame(stopped), 0u);    ///< Остановленная анимация стоит на первом кадре
+    BOOST_CHECK(scheduler.get_finished().empty());
+
+    scheduler.advance(1000);                                ///< Долгий перерыв
+    BOOST_CHECK_EQUAL(scheduler.get_frame(loop), 1u);       ///< 10 смен по модулю 3
+    BOOST_CHECK_EQUAL(scheduler.get_frame(once), 1u);       ///< Нециклическая остается на последнем кадре
+    BOOST_REQUIRE_EQUAL(scheduler.get_finished().size(), 1u);
+    BOOST_CHECK_EQUAL(scheduler.get_finished()[0], once);   ///< Сообщение об окончании
+    BOOST_CHECK(scheduler.is_finished(once));
+    BOOST_CHECK(!scheduler.is_finished(loop));              ///< Циклическая не заканчивается
+    BOOST_CHECK(!scheduler.is_finished(stopped));
+
+    scheduler.advance(1100);
+    BOOST_CHECK(scheduler.get_finished().empty());          ///< Об окончании сообщается один раз
+    BOOST_CHECK(scheduler.is_finished(once));
+}
+
+/**
+ * @brief Тест перезапуска и удаления анимаций.
+ */
+BOOST_AUTO_TEST_CASE(SchedulerRestartRemove) {
+    AnimationScheduler scheduler;
+    AnimationScheduler::Handle first = scheduler.add(2, 100, false, 0);
+    AnimationScheduler::Handle second = scheduler.add(5, 100, true, 0);
+    AnimationScheduler::Handle third = scheduler.add(3, 100, false, -1);
+
+    scheduler.advance(500);
+    BOOST_CHECK(scheduler.is_finished(first));
+
+    scheduler.restart(first, 450);                          ///< Перезапуск сразу снимает окончание
+    BOOST_CHECK(!scheduler.is_finished(first));
+    BOOST_CHECK_EQUAL(scheduler.get_frame(first), 0u);
+    scheduler.restart(third, 500);
+
+    scheduler.remove(first);                                ///< Последняя анимация переезжает на место удаленной
+    BOOST_CHECK_EQUAL(scheduler.size(), 2u);
+    scheduler.advance(700);
+    BOOST_CHECK_EQUAL(scheduler.get_frame(second), 2u);     ///< Дескрипторы оставшихся не меняются
+    BOOST_CHECK_EQUAL(scheduler.get_frame(third), 2u);
+    BOOST_CHECK(scheduler.get_finished().empty());
+
+    AnimationScheduler::Handle reused = scheduler.add(1, 100, false, 700);
+    BOOST_CHECK_EQUAL(reused, first);                       ///< Дескриптор удаленной анимации используется повторно
+    scheduler.advance(800);
+    BOOST_REQUIRE_EQUAL(scheduler.get_finished().size(), 2u);
+    BOOST_CHECK(scheduler.is_finished(third));
+    BOOST_CHECK(scheduler.is_finished(reused));
+}
+
+/**
+ * @brief Тест анимации, часы которой ведет планировщик.
+ */
+BOOST_AUTO_TEST_CASE(ScheduledAnimation) {
+    std::vector<AtlasFrame> frames(3);
+    AnimationScheduler scheduler;
+    Animation anim(frames, 100);
+
+    anim.schedule(scheduler, false, -1);
+    BOOST_CHECK(anim.is_scheduled());
+    anim.start(1000);
+    scheduler.advance(1150);
+    BOOST_CHECK(&anim.get_frame(0) == &frames[1]);          ///< Время вызова не важно, кадр берется у планировщика
+    BOOST_CHECK(!anim.is_end(5000));
+
+    scheduler.advance(1300);
+    BOOST_CHECK(anim.is_end(0));
+    BOOST_REQUIRE_EQUAL(scheduler.get_finished().size(), 1u);
+    BOOST_CHECK_EQUAL(scheduler.get_finished()[0], anim.get_handle());
+
+    anim.unschedule();                                      ///< Снова свои часы
+    BOOST_CHECK(!anim.is_scheduled());
+    BOOST_CHECK_EQUAL(scheduler.size(), 0u);
+    BOOST_CHECK(&anim.get_frame(1100) == &frames[1]);
+}
@@ -0,0 +1,172 @@
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <vector>
+
+#include "assetpack.h"
+#include "textureatlas.h"
+#include "threadpool.h"
+
+/**
+ * @brief Тестирование записи и чтения пака ресурсов.
+ *
+ * Этот тест проверяет, что раскладка атласа, сохраненная в пак, читается
+ * из отображенного файла без изменений: страницы, кадры полос и блоки данных.
+ */
+BOOST_AUTO_TEST_CASE(test_asset_pack_round_trip)
+{
+    const char* path = "test_asset_pack_round_trip.pack";
+
+    // Полоса из двух кадров 8x4, полоса без картинки и полоса без имени
+    sf::Image strip;
+    strip.create(16, 4, sf::Color(10, 20, 30, 40));
+    std::vector<AtlasFrame> frames;
+    std::vector<AtlasFrame> missing_frames;
+    std::vector<AtlasFrame> unnamed_frames;
+    const char glyphs[] = "metrics";
+
+    TextureAtlas atlas;
+    atlas.add_strip(strip, 2, frames, "strip.png");
+    atlas.add_strip(sf::Image(), 3, missing_frames, "missing.png");
+    atlas.add_strip(strip, 1, unnamed_frames);
+    atlas.add_data("font", glyphs, sizeof(glyphs));
+    BOOST_REQUIRE(atlas.save_pack(path, 64));
+
+    AssetPack pack;
+    BOOST_REQUIRE(pack.open(path));
+    BOOST_REQUIRE_EQUAL(pack.get_page_count(), 1u);
+    sf::Vector2u page_size = pack.get_page_size(0);
+    BOOST_CHECK(page_size.x >= 2 * 8 + 16 && page_size.y >= 4); // Три кадра в ряд с зазорами
+    BOOST_CHECK(pack.get_page_pixels(0) != nullptr);
+
+    std::size_t count = 0;
+    const AssetPack::Frame* packed = pack.find_strip("strip.png", count);
+    BOOST_REQUIRE(packed != nullptr);
+    BOOST_REQUIRE_EQUAL(count, 2u);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        BOOST_CHECK_EQUAL(packed[i].page, 0);
+        BOOST_CHECK_EQUAL(packed[i].width, 8);
+        BOOST_CHECK_EQUAL(packed[i].height, 4);
+        BOOST_CHECK(static_cast<unsigned>(packed[i].left + packed[i].width) <= page_size.x);
+    }
+    BOOST_CHECK(packed[0].left != packed[1].left); // Кадры не накладываются
+
+    packed = pack.find_strip("missing.png", count);
+    BOOST_REQUIRE(packed != nullptr);
+    BOOST_REQUIRE_EQUAL(count, 3u);
+    BOOST_CHECK_EQUAL(packed[0].page, -1); // Незагруженная картинка сохраняется пустыми кадрами
+
+    std::size_t size = 0;
+    const char* data = pack.find_data("font", size);
+    BOOST_REQUIRE(data != nullptr);
+    BOOST_REQUIRE_EQUAL(size, sizeof(glyphs));
+    BOOST_CHECK(std::memcmp(data, glyphs, size) == 0);
+    BOOST_CHECK(pack.find_data("strip.png", size) == nullptr);
+
+    pack.close();
+    BOOST_CHECK(!pack.is_open());
+    std::remove(path);
+}
+
+/**
+ * @brief Тестирование отказа открыть поврежденный пак.
+ *
+ * Этот тест проверяет, что пак с неверной сигнатурой, обрезанный пак и
+ * отсутствующий файл не открываются, и игра может читать ресурсы из файлов.
+ */
+BOOST_AUTO_TEST_CASE(test_asset_pack_corrupted)
+{
+    const char* path = "test_asset_pack_corrupted.pack";
+
+    sf::Image page;
+    page.create(32, 32, sf::Color::White);
+    std::vector<AssetPack::Strip> strips{AssetPack::Strip{"strip.png", {AssetPack::Frame{0, 0, 0, 32, 32}}}};
+    BOOST_REQUIRE(AssetPack::write(path, {page}, strips, {}));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    AssetPack pack;
+    BOOST_REQUIRE(pack.open(path));
+    BOOST_CHECK_EQUAL(pack.get_size(), bytes.size());
+
+    // Обрезанный файл: пиксели страницы выходят за конец
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    BOOST_CHECK(!pack.open(path));
+    BOOST_CHECK(!pack.is_open());
+
+    // Неверная сигнатура
+    bytes[0] = 'X';
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    BOOST_CHECK(!pack.open(path));
+
+    std::remove(path);
+    BOOST_CHECK(!pack.open(path));
+}
+
+/**
+ * @brief Тестирование декодирования картинок атласа в пуле потоков.
+ *
+ * Этот тест проверяет, что add_strip с пулом потоков сразу возвращается
+ * с пустыми кадрами, а готовность полос считается отдельно для ресурсов
+ * первого кадра и отложенных ресурсов.
+ */
+BOOST_AUTO_TEST_CASE(test_texture_atlas_async_priorities)
+{
+    const char* path = "test_texture_atlas_async_priorities.pack";
+
+    // Единственный поток пула занят, пока тест не откроет затвор
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    pool.submit([opened]() { opened.wait(); });
+
+    std::vector<AtlasFrame> first_frames;
+    std::vector<AtlasFrame> deferred_frames;
+    TextureAtlas atlas;
+    atlas.set_thread_pool(&pool);
+    BOOST_CHECK(atlas.add_strip("missing_first.png", 2, first_frames));
+    BOOST_CHECK(atlas.add_strip("missing_deferred.png", 3, deferred_frames, TextureAtlas::Priority::Deferred));
+
+    // Кадры есть сразу, но без текстуры
+    BOOST_REQUIRE_EQUAL(first_frames.size(), 2u);
+    BOOST_REQUIRE_EQUAL(deferred_frames.size(), 3u);
+    BOOST_CHECK(first_frames[0].texture == nullptr);
+    BOOST_CHECK(deferred_frames[0].texture == nullptr);
+
+    BOOST_CHECK_EQUAL(atlas.get_pending_count(TextureAtlas::Priority::FirstFrame), 1u);
+    BOOST_CHECK_EQUAL(atlas.get_pending_count(TextureAtlas::Priority::Deferred), 2u);
+    BOOST_CHECK(!atlas.is_ready(TextureAtlas::Priority::FirstFrame));
+    BOOST_CHECK(!atlas.is_ready(TextureAtlas::Priority::Deferred));
+
+    gate.set_value();
+    pool.wait();
+    BOOST_CHECK_EQUAL(atlas.get_pending_count(TextureAtlas::Priority::Deferred), 0u);
+    BOOST_CHECK(atlas.is_ready(TextureAtlas::Priority::FirstFrame));
+    BOOST_CHECK(atlas.is_ready(TextureAtlas::Priority::Deferred));
+
+    // Ошибку декодирования сообщает сборка, а длительности декодирования попадают в отчет
+    BOOST_CHECK(atlas.get_timings().empty());
+    BOOST_CHECK(!atlas.save_pack(path));
+    const std::vector<TextureAtlas::LoadTiming>& timings = atlas.get_timings();
+    BOOST_REQUIRE_EQUAL(timings.size(), 2u);
+    BOOST_CHECK_EQUAL(timings[0].name, "missing_first.png");
+    BOOST_CHECK_EQUAL(timings[1].name, "missing_deferred.png");
+    BOOST_CHECK(timings[0].is_async && timings[1].is_async);
+    BOOST_CHECK(timings[0].microseconds >= 0);
+    BOOST_CHECK_EQUAL(atlas.get_decoded_count(), 2u);
+
+    std::remove(path);
+}
@@ -0,0 +1,195 @@
+#include <boost/test/included/unit_test.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "entitystore.h"
+#include "spatialgrid.h"
+
+/**
+ * @brief Тестирование создания сущности.
+ *
+ * Этот тест проверяет, что созданная сущность получает переданные
+ * границы, тип и состояние по умолчанию (жива и не активирована).
+ */
+BOOST_AUTO_TEST_CASE(test_store_create)
+{
+    EntityStore store;
+
+    EntityHandle handle = store.create(EntityKind::Ice, sf::FloatRect(10.f, 20.f, 30.f, 30.f),
+                                       sf::Vector2f(0.f, 1.f), 150.f);
+
+    BOOST_CHECK_EQUAL(store.size(), 1u);
+    BOOST_CHECK(store.is_valid(handle));
+
+    std::size_t index = store.get_index(handle);
+    BOOST_CHECK(store.get_kind(index) == EntityKind::Ice);
+    BOOST_CHECK(store.is_alive(index));
+    BOOST_CHECK(!store.is_activated(index));
+    BOOST_CHECK_EQUAL(store.get_rect(index).left, 10.f);
+    BOOST_CHECK_EQUAL(store.get_rect(index).top, 20.f);
+}
+
+/**
+ * @brief Тестирование перемещения сущностей.
+ *
+ * Этот тест проверяет, что хранилище перемещает сущности так же,
+ * как ObjectLogic::move: первый вызов только запоминает время.
+ */
+BOOST_AUTO_TEST_CASE(test_store_move)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(0.f, 0.f, 30.f, 30.f), sf::Vector2f(1.f, 0.f), 2.f);
+
+    store.move(0);     // Начальная установка времени
+    store.move(1000);  // Перемещение через 1 секунду
+
+    BOOST_CHECK_CLOSE(store.get_rect(0).left, 2.0f, 0.001);
+    BOOST_CHECK_CLOSE(store.get_rect(0).top, 0.0f, 0.001);
+}
+
+/**
+ * @brief Тестирование интерполяции позиции между перемещениями.
+ *
+ * Этот тест проверяет, что интерполированная позиция лежит между
+ * позициями до и после последнего перемещения.
+ */
+BOOST_AUTO_TEST_CASE(test_store_interpolation)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(0.f, 0.f, 30.f, 30.f), sf::Vector2f(0.f, 1.f), 100.f);
+
+    store.move(0);
+    BOOST_CHECK_EQUAL(store.get_interpolated_rect(0, 0.5f).top, 0.f); // Перемещения еще не было
+
+    store.move(100); // Сдвиг на 10 пикселей вниз
+
+    BOOST_CHECK_CLOSE(store.get_interpolated_rect(0, 0.f).top, 0.f, 0.001);
+    BOOST_CHECK_CLOSE(store.get_interpolated_rect(0, 0.5f).top, 5.f, 0.001);
+    BOOST_CHECK_CLOSE(store.get_interpolated_rect(0, 1.f).top, 10.f, 0.001);
+    BOOST_CHECK_EQUAL(store.get_interpolated_rect(0, 0.5f).height, 30.f);
+}
+
+/**
+ * @brief Тестирование удаления мертвых сущностей.
+ *
+ * Этот тест проверяет, что после уплотнения порядок оставшихся сущностей
+ * сохраняется, их дескрипторы остаются корректными, а дескриптор
+ * удаленной сущности становится недействительным.
+ */
+BOOST_AUTO_TEST_CASE(test_store_remove_dead)
+{
+    EntityStore store;
+    EntityHandle first = store.create(EntityKind::Blum, sf::FloatRect(0.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    EntityHandle second = store.create(EntityKind::Ice, sf::FloatRect(1.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    EntityHandle third = store.create(EntityKind::Bomb, sf::FloatRect(2.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+
+    store.kill(store.get_index(second));
+    BOOST_CHECK_EQUAL(store.remove_dead(), 1u);
+
+    BOOST_CHECK_EQUAL(store.size(), 2u);
+    BOOST_CHECK(!store.is_valid(second));
+    BOOST_CHECK(store.is_valid(first));
+    BOOST_CHECK(store.is_valid(third));
+    BOOST_CHECK_EQUAL(store.get_index(first), 0u);
+    BOOST_CHECK_EQUAL(store.get_index(third), 1u);
+    BOOST_CHECK(store.get_kind(1) == EntityKind::Bomb);
+
+    // Освободившийся слот используется повторно, но со следующим поколением
+    EntityHandle reused = store.create(EntityKind::Blum, sf::FloatRect(3.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    BOOST_CHECK_EQUAL(reused.slot, second.slot);
+    BOOST_CHECK(reused.generation != second.generation);
+}
+
+/**
+ * @brief Тестирование удаления сущностей, покинувших игровое поле.
+ */
+BOOST_AUTO_TEST_CASE(test_store_kill_departed)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(10.f, 10.f, 5.f, 5.f), sf::Vector2f(0.f, 1.f), 1.f);
+    store.create(EntityKind::Blum, sf::FloatRect(10.f, 500.f, 5.f, 5.f), sf::Vector2f(0.f, 1.f), 1.f);
+
+    store.kill_departed(sf::FloatRect(0.f, 0.f, 100.f, 100.f));
+
+    BOOST_CHECK(store.is_alive(0));   // Внутри области
+    BOOST_CHECK(!store.is_alive(1));  // Вне области
+}
+
+/**
+ * @brief Тестирование удаления нажатых сущностей по истечении времени активации.
+ */
+BOOST_AUTO_TEST_CASE(test_store_kill_expired)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(0.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    store.create(EntityKind::Ice, sf::FloatRect(1.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    store.create(EntityKind::Bomb, sf::FloatRect(2.f, 0.f, 1.f, 1.f), sf::Vector2f(0.f, 1.f), 1.f);
+    const int32_t durations[3] = {100, 300, 100};
+
+    store.activate(0, 1000);
+    store.activate(1, 1000);
+
+    // До истечения времени все живы
+    store.kill_expired(1099, durations);
+    BOOST_CHECK(store.is_alive(0));
+    BOOST_CHECK(store.is_alive(1));
+
+    // Blum истек, Ice еще проигрывает анимацию, ненажатая бомба не трогается
+    store.kill_expired(1100, durations);
+    BOOST_CHECK(!store.is_alive(0));
+    BOOST_CHECK(store.is_alive(1));
+    BOOST_CHECK(store.is_alive(2));
+
+    store.kill_expired(1300, durations);
+    BOOST_CHECK(!store.is_alive(1));
+    BOOST_CHECK(store.is_alive(2));
+}
+
+/**
+ * @brief Тестирование поиска сущностей по точке через сетку.
+ *
+ * Этот тест проверяет, что сетка возвращает все сущности, пересекающие
+ * ячейку точки, в порядке плотных индексов, а для точки вне сетки
+ * возвращает пустой диапазон.
+ */
+BOOST_AUTO_TEST_CASE(test_grid_query)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(10.f, 10.f, 20.f, 20.f), sf::Vector2f(0.f, 1.f), 1.f);
+    store.create(EntityKind::Ice, sf::FloatRect(150.f, 150.f, 20.f, 20.f), sf::Vector2f(0.f, 1.f), 1.f);
+    store.create(EntityKind::Bomb, sf::FloatRect(40.f, 40.f, 20.f, 20.f), sf::Vector2f(0.f, 1.f), 1.f); // На стыке четырех ячеек
+
+    SpatialGrid grid(sf::FloatRect(0.f, 0.f, 200.f, 200.f), 50.f);
+    grid.rebuild(store);
+
+    SpatialGrid::Cell cell = grid.query(sf::Vector2f(15.f, 15.f));
+    BOOST_REQUIRE_EQUAL(cell.size(), 2u);
+    BOOST_CHECK_EQUAL(cell.begin()[0], 0u);
+    BOOST_CHECK_EQUAL(cell.begin()[1], 2u);
+
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(55.f, 55.f)).size(), 1u);  // Только бомба
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(160.f, 160.f)).size(), 1u); // Только лед
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(-5.f, 15.f)).size(), 0u);   // Вне сетки
+}
+
+/**
+ * @brief Тестирование перестроения сетки после перемещения сущностей.
+ *
+ * Этот тест проверяет, что после перемещения и повторного перестроения
+ * сущность находится в новой ячейке и пропадает из старой.
+ */
+BOOST_AUTO_TEST_CASE(test_grid_rebuild)
+{
+    EntityStore store;
+    store.create(EntityKind::Blum, sf::FloatRect(10.f, 10.f, 20.f, 20.f), sf::Vector2f(0.f, 1.f), 100.f);
+
+    SpatialGrid grid(sf::FloatRect(0.f, 0.f, 200.f, 200.f), 50.f);
+    grid.rebuild(store);
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(15.f, 15.f)).size(), 1u);
+
+    store.move(0);
+    store.move(1000); // Сдвиг на 100 пикселей вниз
+    grid.rebuild(store);
+
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(15.f, 15.f)).size(), 0u);
+    BOOST_CHECK_EQUAL(grid.query(sf::Vector2f(15.f, 115.f)).size(), 1u);
+}
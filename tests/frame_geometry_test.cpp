@@ -0,0 +1,64 @@
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+#include "animation.h"
+#include "framegeometry.h"
+
+/**
+ * @brief Тест общего кэша вершин кадров.
+ */
+BOOST_AUTO_TEST_CASE(FrameGeometryShared) {
+    std::vector<AtlasFrame> frames(2);
+    frames[0].rect = sf::IntRect(0, 0, 10, 10);
+    frames[1].rect = sf::IntRect(10, 0, 10, 10);
+    std::vector<AtlasFrame> other_frames(1);
+    FrameGeometryCache cache;
+
+    const std::vector<sf::Vertex>& entry = cache.get(frames, sf::Vector2f(30.2f, 29.8f));
+    BOOST_REQUIRE_EQUAL(entry.size(), 2 * FrameGeometryCache::mc_frame_vertices);
+    BOOST_CHECK_EQUAL(entry[1].position.x, 30.f);           ///< Размер округлен до целых пикселей
+    BOOST_CHECK_EQUAL(entry[2].position.y, 30.f);
+    BOOST_CHECK_EQUAL(entry[6].texCoords.x, 10.f);          ///< Второй кадр со своим прямоугольником в текстуре
+    BOOST_CHECK_EQUAL(cache.get_miss_count(), 1u);
+
+    BOOST_CHECK(&cache.get(frames, sf::Vector2f(30.f, 30.f)) == &entry);   ///< Повтор не строит запись заново
+    BOOST_CHECK(&cache.get(frames, sf::Vector2f(29.6f, 30.4f)) == &entry); ///< Близкий размер - та же запись
+    BOOST_CHECK_EQUAL(cache.get_miss_count(), 1u);
+
+    BOOST_CHECK(&cache.get(frames, sf::Vector2f(31.f, 30.f)) != &entry);
+    BOOST_CHECK(&cache.get(other_frames, sf::Vector2f(30.f, 30.f)) != &entry);
+    BOOST_CHECK_EQUAL(cache.size(), 3u);
+    BOOST_CHECK(&cache.get(frames, sf::Vector2f(30.f, 30.f)) == &entry);   ///< Новые записи не перемещают старые
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+    BOOST_CHECK_EQUAL(FrameGeometryCache::round_size(sf::Vector2f(0.2f, 0.f)).x, 1.f); ///< Не меньше пикселя
+}
+
+/**
+ * @brief Тест вершин кадра анимации, взятых из кэша.
+ */
+BOOST_AUTO_TEST_CASE(AnimationCachedBuild) {
+    sf::Texture texture;
+    std::vector<AtlasFrame> frames(1);
+    frames[0].texture = &texture;
+    frames[0].rect = sf::IntRect(0, 0, 20, 20);
+    Animation first(frames, 100);
+    Animation second(frames, 100);
+    std::vector<sf::Vertex> vertices;
+
+    std::size_t misses = Animation::get_geometry_cache().get_miss_count();
+    first.resize(sf::Vector2f(40.f, 40.f));
+    first.resize(sf::Vector2f(40.f, 40.f));                 ///< Повтор того же размера ничего не делает
+    BOOST_CHECK(first.build(vertices, sf::Vector2f(100.f, 50.f), 0) == &texture);
+    BOOST_REQUIRE_EQUAL(vertices.size(), FrameGeometryCache::mc_frame_vertices);
+    BOOST_CHECK_EQUAL(vertices[0].position.x, 100.f);       ///< Вершины сдвинуты на позицию
+    BOOST_CHECK_EQUAL(vertices[4].position.x, 140.f);
+    BOOST_CHECK_EQUAL(vertices[4].position.y, 90.f);
+    BOOST_CHECK_EQUAL(vertices[4].texCoords.x, 20.f);
+
+    second.resize(sf::Vector2f(40.3f, 39.9f));              ///< Анимация близкого размера берет ту же запись
+    second.build(vertices, sf::Vector2f(), 0);
+    BOOST_CHECK_EQUAL(Animation::get_geometry_cache().get_miss_count(), misses + 1);
+    BOOST_CHECK(second.get_size() == sf::Vector2f(40.3f, 39.9f)); ///< Заданный размер сохраняется
+}
@@ -0,0 +1,58 @@
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+#include "glyphfont.h"
+#include "label.h"
+#include "spritebatch.h"
+
+/**
+ * @brief Тестирование пересборки метки только при изменениях.
+ *
+ * Этот тест проверяет, что метка помечается измененной только тогда, когда
+ * новое значение отличается от текущего, а отрисовка снимает пометку.
+ */
+BOOST_AUTO_TEST_CASE(test_label_retained)
+{
+    GlyphFont font; // Шрифт без символов: метке нужны только размеры
+    std::vector<AtlasFrame> frames(1);
+    frames[0].rect = sf::IntRect(0, 0, 40, 20);
+    Label label(frames, 1000, font);
+    SpriteBatch batch;
+
+    BOOST_CHECK(label.is_changed()); // Вершины еще не собраны
+    label.draw(batch, 0);
+    BOOST_CHECK(!label.is_changed());
+
+    label.set_string("12");
+    BOOST_CHECK(label.is_changed());
+    label.draw(batch, 10);
+    BOOST_CHECK(!label.is_changed());
+
+    // Те же значения не требуют пересборки
+    label.set_string("12");
+    label.set_string_scale(1.f);
+    label.set_picture_size(sf::Vector2f(40.f, 20.f));
+    label.set_picture_position(sf::Vector2f(0.f, 0.f));
+    label.set_string_position(sf::Vector2f(0.f, 0.f));
+    label.set_string_settings(sf::Color::White, 0);
+    BOOST_CHECK(!label.is_changed());
+
+    label.set_string_scale(1.5f);
+    BOOST_CHECK(label.is_changed());
+    label.draw(batch, 20);
+
+    label.set_picture_position(sf::Vector2f(5.f, 0.f));
+    BOOST_CHECK(label.is_changed());
+    label.draw(batch, 30);
+
+    label.set_string_settings(sf::Color::Red, 0);
+    BOOST_CHECK(label.is_changed());
+    label.draw(batch, 40);
+
+    // Длинный текст обрезается до наибольшей длины и не портит память
+    label.set_string("1234567890123456789");
+    BOOST_CHECK(label.is_changed());
+    label.draw(batch, 50);
+    label.set_string("123456789012345");
+    BOOST_CHECK(!label.is_changed()); // Совпадает с обрезанным текстом
+}
@@ -3,4 +3,14 @@
 
 #include "object_logic_test.cpp"
 #include "animation_logic_test.cpp"
+#include "animation_scheduler_test.cpp"
+#include "frame_geometry_test.cpp"
+#include "entity_store_test.cpp"
+#include "match_simulation_test.cpp"
+#include "thread_pool_test.cpp"
+#include "replay_test.cpp"
+#include "label_test.cpp"
+#include "vertex_stream_test.cpp"
+#include "sprite_batch_test.cpp"
+#include "asset_pack_test.cpp"
 
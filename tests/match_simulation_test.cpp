@@ -0,0 +1,184 @@
+#include <boost/test/included/unit_test.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include "gameobjects.h"
+#include "matchrandom.h"
+#include "matchsimulation.h"
+#include "spawnparams.h"
+
+/**
+ * @brief Тестирование воспроизводимости матча.
+ *
+ * Этот тест проверяет, что две симуляции с одинаковым начальным значением
+ * генератора создают одинаковые объекты в одинаковых позициях.
+ */
+BOOST_AUTO_TEST_CASE(test_match_deterministic)
+{
+    sf::FloatRect game_board(0.f, 0.f, 402.f, 712.f);
+    MatchSimulation first(game_board, 42);
+    MatchSimulation second(game_board, 42);
+
+    for (int32_t cur_time = 0; cur_time <= 5000; cur_time += 10)
+    {
+        first.update(cur_time);
+        second.update(cur_time);
+    }
+
+    const EntityStore& a = first.get_entities();
+    const EntityStore& b = second.get_entities();
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+    BOOST_CHECK(a.size() > 0u);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        BOOST_CHECK(a.get_kind(i) == b.get_kind(i));
+        BOOST_CHECK_EQUAL(a.get_rect(i).left, b.get_rect(i).left);
+        BOOST_CHECK_EQUAL(a.get_rect(i).top, b.get_rect(i).top);
+    }
+}
+
+/**
+ * @brief Тестирование нажатия на объект и промаха.
+ *
+ * Этот тест проверяет, что клик по Blum увеличивает счет и статистику,
+ * повторный клик по нему же считается промахом, а бомба отнимает
+ * очки, не опуская счет ниже нуля.
+ */
+BOOST_AUTO_TEST_CASE(test_match_click)
+{
+    MatchSimulation match(sf::FloatRect(0.f, 0.f, 402.f, 712.f), 1);
+    match.set_spawn_chances(1000, 0, 0); // Только Blum
+    match.update(0);
+
+    const EntityStore& entities = match.get_entities();
+    BOOST_REQUIRE_EQUAL(entities.size(), 1u);
+    sf::FloatRect rect = entities.get_rect(0);
+    sf::Vector2f center(rect.left + rect.width / 2.f, rect.top + rect.height / 2.f);
+
+    match.click(center);
+    BOOST_CHECK_EQUAL(match.get_cash(), 1);
+    BOOST_CHECK_EQUAL(match.get_statistics().at("blum"), 1u);
+    BOOST_CHECK(entities.is_activated(0));
+
+    match.click(center); // Объект уже активирован
+    BOOST_CHECK_EQUAL(match.get_cash(), 1);
+    BOOST_CHECK_EQUAL(match.get_statistics().at("miss"), 1u);
+
+    // Бомба отнимает 100 очков, но счет не становится отрицательным
+    match.set_spawn_chances(0, 0, 1000);
+    for (int32_t cur_time = 1; entities.size() < 2 && cur_time < 100; ++cur_time)
+        match.update(cur_time); // Вероятность 1000 из 1001, поэтому ждем появления бомбы
+    BOOST_REQUIRE_EQUAL(entities.size(), 2u);
+    rect = entities.get_rect(1);
+    match.click(sf::Vector2f(rect.left + 1.f, rect.top + 1.f));
+    BOOST_CHECK_EQUAL(match.get_cash(), 0);
+    BOOST_CHECK_EQUAL(match.get_statistics().at("bomb"), 1u);
+}
+
+/**
+ * @brief Тестирование заморозки и окончания матча.
+ *
+ * Этот тест проверяет, что клик по Ice останавливает таймер на время
+ * заморозки, а матч заканчивается через 45 секунд игрового времени
+ * плюс время заморозки.
+ */
+BOOST_AUTO_TEST_CASE(test_match_freeze_and_game_over)
+{
+    MatchSimulation match(sf::FloatRect(0.f, 0.f, 402.f, 712.f), 7);
+    match.set_spawn_chances(0, 1000, 0); // Только Ice
+    match.update(0);
+
+    const EntityStore& entities = match.get_entities();
+    BOOST_REQUIRE(!entities.empty());
+    sf::FloatRect rect = entities.get_rect(0);
+    match.click(sf::Vector2f(rect.left + 1.f, rect.top + 1.f));
+    BOOST_CHECK(match.is_freezing());
+
+    match.set_spawn_chances(0, 0, 0);
+    int32_t cur_time = 0;
+    for (cur_time = 10; cur_time <= 2010; cur_time += 10) // Заморозка начинается со следующего обновления
+        match.update(cur_time);
+    BOOST_CHECK(!match.is_freezing());
+    BOOST_CHECK_EQUAL(match.get_seconds_left(), 45); // Время в заморозке не учитывается
+
+    for (; cur_time <= 46500; cur_time += 10)
+        match.update(cur_time);
+    BOOST_CHECK(!match.is_game_over());
+
+    for (; cur_time <= 48000; cur_time += 10)
+        match.update(cur_time);
+    BOOST_CHECK(match.is_game_over());
+}
+
+/**
+ * @brief Тестирование воспроизводимости и диапазонов генератора матча.
+ *
+ * Этот тест проверяет, что генераторы с одинаковым начальным значением
+ * дают одинаковые последовательности, с разным - разные, а числа
+ * below и uniform лежат в заданных диапазонах.
+ */
+BOOST_AUTO_TEST_CASE(test_match_random)
+{
+    MatchRandom first(123);
+    MatchRandom second(123);
+    MatchRandom other(124);
+
+    bool differs = false;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::uint32_t value = first();
+        BOOST_CHECK_EQUAL(value, second());
+        differs = differs || value != other();
+    }
+    BOOST_CHECK(differs);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        BOOST_CHECK(first.below(1001) <= 1000u);
+        float value = first.uniform(150.f, 200.f);
+        BOOST_CHECK(value >= 150.f && value <= 200.f);
+    }
+}
+
+/**
+ * @brief Тестирование пакетной генерации параметров появления.
+ *
+ * Этот тест проверяет, что пакетная генерация дает те же параметры,
+ * что и последовательные вызовы для одного объекта, и что параметры
+ * лежат в допустимых пределах.
+ */
+BOOST_AUTO_TEST_CASE(test_spawn_params_batch)
+{
+    sf::FloatRect game_board(0.f, 0.f, 402.f, 712.f);
+    MatchRandom batch_random(5);
+    MatchRandom single_random(5);
+
+    SpawnParams batch[3];
+    make_spawn_params(game_board, batch_random, batch, 3);
+    for (const SpawnParams& params : batch)
+    {
+        SpawnParams single = make_spawn_params(game_board, single_random);
+        BOOST_CHECK_EQUAL(params.position.x, single.position.x);
+        BOOST_CHECK_EQUAL(params.size.x, single.size.x);
+        BOOST_CHECK_EQUAL(params.speed, single.speed);
+
+        BOOST_CHECK(params.size.x >= 26.f && params.size.x <= 45.f);
+        BOOST_CHECK(params.position.x >= 0.f && params.position.x + params.size.x <= 402.f);
+        BOOST_CHECK_EQUAL(params.position.y, -params.size.y); // Над полем
+    }
+}
+
+/**
+ * @brief Тестирование согласованности времени жизни нажатого объекта с его анимацией.
+ *
+ * Этот тест проверяет, что симуляция удаляет нажатый объект ровно тогда,
+ * когда заканчивается анимация активации его внешнего вида.
+ */
+BOOST_AUTO_TEST_CASE(test_match_activation_time)
+{
+    BOOST_CHECK_EQUAL(MatchSimulation::get_activation_time(EntityKind::Blum),
+                      static_cast<int32_t>(Blum::mc_activ_frame_count) * Blum::mc_activ_change_time);
+    BOOST_CHECK_EQUAL(MatchSimulation::get_activation_time(EntityKind::Ice),
+                      static_cast<int32_t>(Ice::mc_activ_frame_count) * Ice::mc_activ_change_time);
+    BOOST_CHECK_EQUAL(MatchSimulation::get_activation_time(EntityKind::Bomb),
+                      static_cast<int32_t>(Bomb::mc_activ_frame_count) * Bomb::mc_activ_change_time);
+}
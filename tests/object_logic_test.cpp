@@ -1,6 +1,9 @@
 #include <boost/test/included/unit_test.hpp>
 #include <SFML/Graphics.hpp>
 
+#include <vector>
+
+#include "kinematics.h"
 #include "object.h"
 
 /**
@@ -89,3 +92,79 @@ BOOST_AUTO_TEST_CASE(test_move)
     BOOST_CHECK_CLOSE(new_position.x, 2.0f, 0.001);  // Ожидаемое смещение вдоль оси X
     BOOST_CHECK_CLOSE(new_position.y, 0.0f, 0.001);  // Смещение вдоль оси Y должно быть 0
 }
+
+/**
+ * @brief Тестирование пакетного перемещения объектов.
+ *
+ * Этот тест проверяет, что BatchKinematics::advance дает тот же результат,
+ * что и ObjectLogic::move для каждого объекта отдельно, во всех ядрах,
+ * которые поддерживает процессор. Количество объектов не кратно ширине
+ * векторов, чтобы проверить и обработку остатка.
+ */
+BOOST_AUTO_TEST_CASE(test_batch_move_matches_object_move)
+{
+    const std::size_t n = 37;
+    const int32_t delta_time = 17;
+
+    // Эталон: перемещаем каждый объект через ObjectLogic
+    std::vector<ObjectLogic> objects(n);
+    std::vector<float> start_x(n), start_y(n), dir_x(n), dir_y(n), speed(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        start_x[i] = 3.5f * i;
+        start_y[i] = -40.f + 1.25f * i;
+        speed[i] = 150.f + i;
+
+        // Разные направления, включая нулевое (заморозка)
+        sf::Vector2f direct(i % 3 == 0 ? 0.f : 1.f, i % 5 == 0 ? 0.f : 2.f);
+        objects[i].set_position(sf::Vector2f(start_x[i], start_y[i]));
+        objects[i].set_direction(direct);
+        objects[i].set_speed(speed[i]);
+        objects[i].move(0);
+        objects[i].move(delta_time);
+
+        // Нормализуем направление так же, как ObjectLogic::set_direction
+        float length = std::sqrt(direct.x * direct.x + direct.y * direct.y);
+        dir_x[i] = length != 0.f ? direct.x / length : 0.f;
+        dir_y[i] = length != 0.f ? direct.y / length : 0.f;
+    }
+
+    const BatchKinematics::Kernel kernels[] = {
+        BatchKinematics::Kernel::Scalar,
+        BatchKinematics::Kernel::Sse2,
+        BatchKinematics::Kernel::Avx2
+    };
+    BatchKinematics::Kernel default_kernel = BatchKinematics::get_kernel();
+
+    for (BatchKinematics::Kernel kernel : kernels)
+    {
+        if (!BatchKinematics::set_kernel(kernel)) // Ядро не поддерживается процессором
+            continue;
+
+        std::vector<float> pos_x = start_x;
+        std::vector<float> pos_y = start_y;
+        BatchKinematics::advance(pos_x.data(), pos_y.data(), dir_x.data(), dir_y.data(),
+                                 speed.data(), n, delta_time);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            sf::FloatRect expected = objects[i].get_rect();
+            BOOST_CHECK_SMALL(pos_x[i] - expected.left, 1e-4f);
+            BOOST_CHECK_SMALL(pos_y[i] - expected.top, 1e-4f);
+        }
+    }
+
+    BatchKinematics::set_kernel(default_kernel);
+}
+
+/**
+ * @brief Тестирование выбора ядра пакетного перемещения.
+ *
+ * Скалярное ядро поддерживается всегда, а ядро по умолчанию -
+ * одно из поддерживаемых процессором.
+ */
+BOOST_AUTO_TEST_CASE(test_batch_kernel_selection)
+{
+    BOOST_CHECK(BatchKinematics::is_supported(BatchKinematics::Kernel::Scalar));
+    BOOST_CHECK(BatchKinematics::is_supported(BatchKinematics::get_kernel()));
+}
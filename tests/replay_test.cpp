@@ -0,0 +1,132 @@
+#include <boost/test/included/unit_test.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "matchrandom.h"
+#include "matchsimulation.h"
+#include "replay.h"
+
+namespace
+{
+    /**
+     * @brief Играет матч по синтетическим часам и записывает его в файл повтора.
+     * @param path Путь к файлу повтора.
+     * @param seed Начальное значение генератора матча.
+     * @param corrupt_tick Шаг, на котором записывается неверная контрольная сумма (0 - нигде).
+     * @param clicks Количество сделанных кликов.
+     * @return Итоговый счет матча.
+     */
+    int record_match(const char* path, std::uint64_t seed, std::uint32_t corrupt_tick, std::size_t& clicks)
+    {
+        ReplayHeader header;
+        header.seed = seed;
+        header.tick_time = 10;
+        MatchSimulation match(header.game_board, seed);
+        MatchRandom player(seed + 1);
+
+        ReplayWriter writer(256); // Маленький буфер, чтобы он заполнялся во время записи
+        BOOST_REQUIRE(writer.open(path, header));
+
+        clicks = 0;
+        int32_t cur_time = 0;
+        while (!match.is_game_over())
+        {
+            match.update(cur_time);
+            cur_time += header.tick_time;
+            std::uint32_t checksum = match.get_checksum();
+            writer.record_checksum(match.get_tick(), match.get_tick() == corrupt_tick ? checksum + 1 : checksum);
+
+            const EntityStore& entities = match.get_entities();
+            if (player.below(5) != 0 || entities.empty())
+                continue;
+
+            // Клик в центр случайного объекта с округлением до пикселя, как в окне
+            sf::FloatRect rect = entities.get_rect(player.below(static_cast<std::uint32_t>(entities.size())));
+            sf::Vector2i pos(static_cast<int>(std::lround(rect.left + rect.width / 2.f)),
+                             static_cast<int>(std::lround(rect.top + rect.height / 2.f)));
+            writer.record_click(match.get_tick(), pos);
+            match.click(sf::Vector2f(pos));
+            ++clicks;
+        }
+        writer.finish(match.get_tick());
+        return match.get_cash();
+    }
+}
+
+/**
+ * @brief Тестирование записи и воспроизведения матча.
+ *
+ * Этот тест проверяет, что воспроизведение записанного матча проходит
+ * те же состояния (все контрольные суммы совпадают) и дает тот же счет.
+ */
+BOOST_AUTO_TEST_CASE(test_replay_round_trip)
+{
+    const char* path = "test_replay_round_trip.blrp";
+    std::size_t clicks = 0;
+    int cash = record_match(path, 7, 0, clicks);
+
+    ReplayResult result;
+    BOOST_REQUIRE(play_replay(path, result));
+    std::remove(path);
+
+    BOOST_CHECK(result.finished);
+    BOOST_CHECK_EQUAL(result.header.seed, 7u);
+    BOOST_CHECK_EQUAL(result.header.tick_time, 10);
+    BOOST_CHECK(result.ticks > 4500u); // 45 секунд матча и время заморозки
+    BOOST_CHECK_EQUAL(result.checked, result.ticks);
+    BOOST_CHECK_EQUAL(result.mismatches, 0u);
+    BOOST_CHECK_EQUAL(result.clicks, clicks);
+    BOOST_CHECK(clicks > 0u);
+    BOOST_CHECK_EQUAL(result.cash, cash);
+}
+
+/**
+ * @brief Тестирование обнаружения расхождений и поврежденных файлов.
+ *
+ * Этот тест проверяет, что неверная контрольная сумма находится на своем
+ * шаге, обрезанный повтор не считается завершенным, а файл с неверной
+ * сигнатурой не воспроизводится.
+ */
+BOOST_AUTO_TEST_CASE(test_replay_mismatch)
+{
+    const char* path = "test_replay_mismatch.blrp";
+    std::size_t clicks = 0;
+    record_match(path, 11, 1234, clicks);
+
+    ReplayResult result;
+    BOOST_REQUIRE(play_replay(path, result));
+    BOOST_CHECK(result.finished);
+    BOOST_CHECK_EQUAL(result.mismatches, 1u);
+    BOOST_CHECK_EQUAL(result.first_mismatch_tick, 1234u);
+
+    std::vector<char> data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    BOOST_REQUIRE(data.size() > 100u);
+
+    // Без последних байт пропадает запись о конце матча
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size() / 2));
+    }
+    ReplayResult truncated;
+    play_replay(path, truncated);
+    BOOST_CHECK(!truncated.finished);
+
+    // Неверная сигнатура
+    data[0] = 'X';
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    BOOST_CHECK(!play_replay(path, result));
+    std::remove(path);
+
+    BOOST_CHECK(!play_replay("missing_replay.blrp", result));
+}
@@ -0,0 +1,199 @@
+#include <boost/test/included/unit_test.hpp>
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "spritebatch.h"
+
+namespace
+{
+    /**
+     * @brief Цель отрисовки без контекста OpenGL.
+     *
+     * sf::RenderTarget рисует, только если удалось активировать контекст,
+     * поэтому вызовы отрисовки ничего не делают, а пакет проверяется по
+     * своим счетчикам и списку вызовов без видеокарты.
+     */
+    class NullRenderTarget : public sf::RenderTarget
+    {
+    public:
+        sf::Vector2u getSize(void) const override
+        {
+            return sf::Vector2u(100, 100);
+        }
+
+        bool setActive(bool active = true) override
+        {
+            (void)active;
+            return false;
+        }
+    };
+
+    /**
+     * @brief Добавляет в пакет прямоугольник 10x10 в заданной позиции.
+     * @param batch Пакет отрисовки.
+     * @param layer Слой.
+     * @param texture Текстура.
+     * @param x Позиция по оси X.
+     */
+    void add_quad(SpriteBatch& batch, SpriteBatch::Layer layer, const sf::Texture& texture, float x)
+    {
+        batch.add(layer, texture, sf::FloatRect(x, 0.f, 10.f, 10.f), sf::IntRect(0, 0, 10, 10));
+    }
+}
+
+/**
+ * @brief Тестирование порядка отрисовки в слое меток.
+ *
+ * Этот тест проверяет, что в слое меток прямоугольники рисуются в порядке
+ * добавления, даже если текстура текста уже установлена предыдущим слоем:
+ * иначе текст метки оказался бы под ее картинкой.
+ */
+BOOST_AUTO_TEST_CASE(test_sprite_batch_labels_order)
+{
+    NullRenderTarget target;
+    sf::Texture picture;
+    sf::Texture font;
+    SpriteBatch batch;
+
+    // Числа оставляют установленной текстуру шрифта
+    add_quad(batch, SpriteBatch::Layer::Numbers, font, 0.f);
+    // Две метки: картинка, затем текст
+    add_quad(batch, SpriteBatch::Layer::Labels, picture, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, font, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, font, 10.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, picture, 50.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, font, 50.f);
+    batch.draw(target);
+
+    // Идущие подряд прямоугольники текста объединяются, остальные рисуются по порядку
+    const std::vector<SpriteBatch::DrawCall>& calls = batch.get_draw_list();
+    BOOST_REQUIRE_EQUAL(calls.size(), 5u);
+    BOOST_CHECK(calls[0].layer == SpriteBatch::Layer::Numbers);
+    const sf::Texture* expected[] = {&font, &picture, &font, &picture, &font};
+    std::size_t expected_quads[] = {1, 1, 2, 1, 1};
+    for (std::size_t i = 0; i < calls.size(); ++i)
+    {
+        BOOST_CHECK(calls[i].texture == expected[i]);
+        BOOST_CHECK_EQUAL(calls[i].quads, expected_quads[i]);
+    }
+    BOOST_CHECK_EQUAL(batch.get_state_changes(), 5u);
+
+    // Следующий кадр с тем же содержимым повторяет порядок
+    batch.clear();
+    BOOST_CHECK(batch.get_draw_list().empty());
+    add_quad(batch, SpriteBatch::Layer::Numbers, font, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, picture, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, font, 0.f);
+    batch.draw(target);
+    BOOST_REQUIRE_EQUAL(batch.get_draw_list().size(), 3u);
+    BOOST_CHECK(batch.get_draw_list()[1].texture == &picture);
+    BOOST_CHECK(batch.get_draw_list()[2].texture == &font);
+}
+
+/**
+ * @brief Тестирование счетчиков вызовов отрисовки и смен состояния.
+ *
+ * Этот тест проверяет, что прямоугольники слоя с одной текстурой рисуются
+ * одним вызовом, а слой, в котором есть текстура последнего вызова
+ * предыдущего слоя, начинается с нее и не переключает состояние на стыке.
+ */
+BOOST_AUTO_TEST_CASE(test_sprite_batch_state_changes)
+{
+    NullRenderTarget target;
+    sf::Texture first;
+    sf::Texture second;
+    SpriteBatch batch;
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        // Фон: первая, вторая и снова первая текстура - два пакета, последней рисуется вторая
+        batch.clear();
+        add_quad(batch, SpriteBatch::Layer::Background, first, 0.f);
+        add_quad(batch, SpriteBatch::Layer::Background, second, 10.f);
+        add_quad(batch, SpriteBatch::Layer::Background, first, 20.f);
+        // Объекты: те же текстуры в другом порядке
+        add_quad(batch, SpriteBatch::Layer::Objects, first, 0.f);
+        add_quad(batch, SpriteBatch::Layer::Objects, second, 10.f);
+        batch.draw(target);
+
+        BOOST_CHECK_EQUAL(batch.get_draw_calls(), 4u);
+        BOOST_CHECK_EQUAL(batch.get_quad_count(), 5u);
+        // Первая и вторая текстура фона и первая текстура объектов; вторая на стыке слоев не переключается
+        BOOST_CHECK_EQUAL(batch.get_state_changes(), 3u);
+        BOOST_CHECK_EQUAL(batch.get_pixel_count(), 500u);
+
+        const std::vector<SpriteBatch::DrawCall>& calls = batch.get_draw_list();
+        BOOST_REQUIRE_EQUAL(calls.size(), 4u);
+        BOOST_CHECK(calls[0].texture == &first);
+        BOOST_CHECK_EQUAL(calls[0].quads, 2u);
+        BOOST_CHECK(calls[1].texture == &second);
+        BOOST_CHECK(calls[2].layer == SpriteBatch::Layer::Objects);
+        BOOST_CHECK(calls[2].texture == &second);
+        BOOST_CHECK(calls[3].texture == &first);
+    }
+
+    // Рисование слоев по частям не сбрасывает установленное состояние
+    batch.clear();
+    add_quad(batch, SpriteBatch::Layer::Objects, first, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Labels, first, 0.f);
+    batch.draw(target, SpriteBatch::Layer::Background, SpriteBatch::Layer::Overlay);
+    batch.draw(target, SpriteBatch::Layer::Labels, SpriteBatch::Layer::Labels);
+    BOOST_CHECK_EQUAL(batch.get_draw_calls(), 2u);
+    BOOST_CHECK_EQUAL(batch.get_state_changes(), 1u);
+}
+
+/**
+ * @brief Тестирование группировки прямоугольников по слоям и текстурам.
+ *
+ * Этот тест проверяет, что прямоугольники, добавленные вперемешку во все
+ * пять слоев с двумя текстурами, рисуются одним вызовом на пару (слой,
+ * текстура), а слои рисуются по порядку независимо от порядка добавления.
+ */
+BOOST_AUTO_TEST_CASE(test_sprite_batch_layers)
+{
+    NullRenderTarget target;
+    sf::Texture first;
+    sf::Texture second;
+    SpriteBatch batch;
+
+    // Добавляем от верхнего слоя к нижнему, текстуры вперемешку
+    add_quad(batch, SpriteBatch::Layer::Labels, first, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Overlay, second, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Numbers, first, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Numbers, second, 10.f);
+    add_quad(batch, SpriteBatch::Layer::Objects, first, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Objects, second, 10.f);
+    add_quad(batch, SpriteBatch::Layer::Objects, first, 20.f);
+    add_quad(batch, SpriteBatch::Layer::Objects, second, 30.f);
+    add_quad(batch, SpriteBatch::Layer::Objects, first, 40.f);
+    add_quad(batch, SpriteBatch::Layer::Background, second, 0.f);
+    add_quad(batch, SpriteBatch::Layer::Background, second, 10.f);
+    batch.draw(target);
+
+    // Фон, объекты (две текстуры), числа (две текстуры), заморозка, метки
+    const std::vector<SpriteBatch::DrawCall>& calls = batch.get_draw_list();
+    BOOST_REQUIRE_EQUAL(calls.size(), 7u);
+    BOOST_CHECK_EQUAL(batch.get_draw_calls(), 7u);
+    BOOST_CHECK_EQUAL(batch.get_quad_count(), 11u);
+
+    const SpriteBatch::Layer layers[] = {SpriteBatch::Layer::Background, SpriteBatch::Layer::Objects,
+                                         SpriteBatch::Layer::Objects, SpriteBatch::Layer::Numbers,
+                                         SpriteBatch::Layer::Numbers, SpriteBatch::Layer::Overlay,
+                                         SpriteBatch::Layer::Labels};
+    for (std::size_t i = 0; i < calls.size(); ++i)
+        BOOST_CHECK(calls[i].layer == layers[i]);
+
+    // Текстуры внутри слоев: в каждом слое каждая текстура встречается один раз
+    BOOST_CHECK(calls[0].texture == &second);
+    BOOST_CHECK_EQUAL(calls[0].quads, 2u);
+    for (std::size_t i : {1u, 3u})
+    {
+        BOOST_CHECK(calls[i].texture != calls[i + 1].texture);
+        const SpriteBatch::DrawCall& first_call = calls[i].texture == &first ? calls[i] : calls[i + 1];
+        const SpriteBatch::DrawCall& second_call = calls[i].texture == &second ? calls[i] : calls[i + 1];
+        BOOST_CHECK_EQUAL(first_call.quads, i == 1 ? 3u : 1u);
+        BOOST_CHECK_EQUAL(second_call.quads, i == 1 ? 2u : 1u);
+    }
+    BOOST_CHECK(calls[5].texture == &second);
+    BOOST_CHECK(calls[6].texture == &first);
+}
@@ -20,13 +20,55 @@ LIBS += -lsfml-graphics -lsfml-window -lsfml-system
 
 HEADERS +=  \
     ../app/animation.h \
-    ../app/object.h
+    ../app/animationscheduler.h \
+    ../app/assetpack.h \
+    ../app/framegeometry.h \
+    ../app/glyphfont.h \
+    ../app/label.h \
+    ../app/object.h \
+    ../app/spritebatch.h \
+    ../app/textureatlas.h \
+    ../app/vertexstream.h \
+    ../core/entitystore.h \
+    ../core/kinematics.h \
+    ../core/matchrandom.h \
+    ../core/matchsimulation.h \
+    ../core/replay.h \
+    ../core/spatialgrid.h \
+    ../core/spawnparams.h \
+    ../core/threadpool.h
 
 SOURCES +=  \
     ../app/animation.cpp \
+    ../app/animationscheduler.cpp \
+    ../app/assetpack.cpp \
+    ../app/framegeometry.cpp \
+    ../app/glyphfont.cpp \
+    ../app/label.cpp \
     ../app/object.cpp \
+    ../app/spritebatch.cpp \
+    ../app/textureatlas.cpp \
+    ../app/vertexstream.cpp \
+    ../core/entitystore.cpp \
+    ../core/kinematics.cpp \
+    ../core/matchrandom.cpp \
+    ../core/matchsimulation.cpp \
+    ../core/replay.cpp \
+    ../core/spatialgrid.cpp \
+    ../core/spawnparams.cpp \
+    ../core/threadpool.cpp \
     animation_logic_test.cpp \
+    animation_scheduler_test.cpp \
+    asset_pack_test.cpp \
+    entity_store_test.cpp \
+    frame_geometry_test.cpp \
+    label_test.cpp \
     main.cpp \
-    object_logic_test.cpp
+    match_simulation_test.cpp \
+    object_logic_test.cpp \
+    replay_test.cpp \
+    sprite_batch_test.cpp \
+    thread_pool_test.cpp \
+    vertex_stream_test.cpp
 
-INCLUDEPATH += ../app
+INCLUDEPATH += ../app ../core
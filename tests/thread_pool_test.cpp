@@ -0,0 +1,57 @@
+#include <boost/test/included/unit_test.hpp>
+#include <atomic>
+#include <vector>
+
+#include "threadpool.h"
+
+/**
+ * @brief Тестирование выполнения всех задач пулом потоков.
+ *
+ * Этот тест проверяет, что после wait выполнены все задачи, в том числе
+ * задачи, добавленные из других задач.
+ */
+BOOST_AUTO_TEST_CASE(test_thread_pool_runs_all)
+{
+    std::atomic<int> counter{0};
+    std::vector<int> done(100, 0);
+    {
+        ThreadPool pool(4);
+        BOOST_CHECK_EQUAL(pool.get_thread_count(), 4u);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&pool, &counter, &done, i]() {
+                done[i] = 1;
+                // Вложенная задача попадает в очередь текущего потока
+                pool.submit([&counter]() { ++counter; });
+            });
+        }
+        pool.wait();
+
+        BOOST_CHECK_EQUAL(counter.load(), 100);
+        for (int value : done)
+            BOOST_CHECK_EQUAL(value, 1);
+    }
+}
+
+/**
+ * @brief Тестирование повторного использования пула.
+ *
+ * Этот тест проверяет, что после wait в пул можно добавлять новые задачи,
+ * а деструктор дожидается их выполнения.
+ */
+BOOST_AUTO_TEST_CASE(test_thread_pool_reuse)
+{
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(2);
+        pool.submit([&counter]() { ++counter; });
+        pool.wait();
+        BOOST_CHECK_EQUAL(counter.load(), 1);
+
+        for (int i = 0; i < 10; ++i)
+            pool.submit([&counter]() { ++counter; });
+    } // Деструктор ждет выполнения оставшихся задач
+
+    BOOST_CHECK_EQUAL(counter.load(), 11);
+}
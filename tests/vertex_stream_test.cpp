@@ -0,0 +1,116 @@
+#include <boost/test/included/unit_test.hpp>
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "spritebatch.h"
+#include "vertexstream.h"
+
+/**
+ * @brief Тестирование сбора измененных диапазонов постоянного буфера вершин.
+ *
+ * Этот тест проверяет, что в диапазоны для загрузки попадают только слоты,
+ * вершины которых изменились, что близкие слоты объединяются в один
+ * диапазон, а слоты без записи за кадр очищаются. Видеопамять не
+ * используется: проверяется только работа с копией буфера.
+ */
+BOOST_AUTO_TEST_CASE(test_vertex_stream_dirty_ranges)
+{
+    VertexStream stream(6);
+    std::vector<sf::Vertex> quad;
+    SpriteBatch::append_quad(quad, sf::FloatRect(0.f, 0.f, 10.f, 10.f), sf::IntRect(0, 0, 10, 10));
+    std::vector<sf::Vertex> moved;
+    SpriteBatch::append_quad(moved, sf::FloatRect(0.f, 5.f, 10.f, 10.f), sf::IntRect(0, 0, 10, 10));
+
+    // Первый кадр: записанные слоты 0..2 - один диапазон
+    stream.begin();
+    for (std::size_t slot = 0; slot < 3; ++slot)
+        stream.write(slot, quad.data(), quad.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 0u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 18u);
+    BOOST_CHECK_EQUAL(stream.get_written_slots(), 3u);
+    BOOST_CHECK_EQUAL(stream.get_pixel_count(), 300u);
+
+    // Те же вершины ничего не меняют
+    stream.begin();
+    for (std::size_t slot = 0; slot < 3; ++slot)
+        stream.write(slot, quad.data(), quad.size());
+    stream.finish();
+    BOOST_CHECK(stream.get_dirty_ranges().empty());
+
+    // Сдвинулся только объект в слоте 1
+    stream.begin();
+    stream.write(0, quad.data(), quad.size());
+    stream.write(1, moved.data(), moved.size());
+    stream.write(2, quad.data(), quad.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 6u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 6u);
+
+    // Слот 2 не записан (объект удален) и очищается, новые слоты 3..19 до далекого слота 20
+    // тоже загружаются, поэтому все они - один диапазон
+    stream.begin();
+    stream.write(0, quad.data(), quad.size());
+    stream.write(1, moved.data(), moved.size());
+    stream.write(20, quad.data(), quad.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 12u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 114u);
+    BOOST_CHECK_EQUAL(stream.get_pixel_count(), 300u);
+
+    // Далекий записанный слот при уже загруженных слотах - отдельный диапазон
+    stream.begin();
+    stream.write(0, quad.data(), quad.size());
+    stream.write(1, moved.data(), moved.size());
+    stream.write(20, moved.data(), moved.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 120u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 6u);
+
+    // Слоты 0 и 3 рядом: объединяются вместе с чистыми слотами между ними
+    stream.begin();
+    stream.write(0, moved.data(), moved.size());
+    stream.write(1, moved.data(), moved.size());
+    stream.write(3, quad.data(), quad.size());
+    stream.write(20, moved.data(), moved.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 0u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 24u);
+}
+
+/**
+ * @brief Тестирование загрузки слотов, пропущенных при росте буфера.
+ *
+ * Этот тест проверяет, что слоты между последним записанным и новым
+ * дальним слотом попадают в диапазоны для загрузки, даже если их
+ * вырожденные вершины не отличаются от вершин по умолчанию: иначе
+ * видеопамять, выделенная с запасом, осталась бы в них неинициализированной.
+ */
+BOOST_AUTO_TEST_CASE(test_vertex_stream_grown_slots)
+{
+    VertexStream stream(6);
+    std::vector<sf::Vertex> quad;
+    SpriteBatch::append_quad(quad, sf::FloatRect(0.f, 0.f, 10.f, 10.f), sf::IntRect(0, 0, 10, 10));
+
+    stream.begin();
+    stream.write(0, quad.data(), quad.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 0u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 6u);
+
+    // Слоты 1 и 2 не записаны, но появились вместе со слотом 3
+    stream.begin();
+    stream.write(0, quad.data(), quad.size());
+    stream.write(3, quad.data(), quad.size());
+    stream.finish();
+    BOOST_REQUIRE_EQUAL(stream.get_dirty_ranges().size(), 1u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].first, 6u);
+    BOOST_CHECK_EQUAL(stream.get_dirty_ranges()[0].second, 18u);
+    BOOST_CHECK_EQUAL(stream.get_written_slots(), 2u);
+}